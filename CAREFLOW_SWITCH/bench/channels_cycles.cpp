@@ -0,0 +1,70 @@
+// Channel scheduler interrupt cost in CPU cycles per ms - the session tick, the envelope tick and the software PWM
+// frame with 0 to 4 channels running, channels 1-2 on the Timer2 hardware PWM pins, channels 3-4 software PWM
+// build and run in simavr, no board needed (the results come out on the console):  pio run -e channels_bench -t upload
+// on a board, flash .pio/build/channels_bench/firmware.hex as the sketch is and watch the serial monitor at 115200
+//
+// Timer1 belongs to the scheduler, so the cost is taken from the main loop instead: an idle loop is counted for
+// a while with n channels running, the cycles the interrupts took are the iterations that went missing.
+#include <Arduino.h>
+#include <avr/sleep.h>
+#include <Session.h>
+#include <Waveform.h>
+
+#define RUN_MS 2000             //length of each count
+
+const uint8_t pins[WAVE_CHANNELS] = {11, 3, 5, 9};
+const WaveStep benchLevel[WAVE_CHANNELS][2] PROGMEM = {     //a different level per channel, so every software channel has its own edge
+    {{64, 250}, {0, 0}}, {{96, 250}, {0, 0}}, {{128, 250}, {0, 0}}, {{192, 250}, {0, 0}}
+};
+
+volatile uint32_t sink;
+
+//idle loop iterations in RUN_MS, the loop body is the same for every count
+uint32_t __attribute__((noinline)) spin(){
+
+    uint32_t n = 0;
+    uint32_t start = millis();
+    while(millis() - start < RUN_MS){n++;}
+    return n;
+}
+
+void setup(){
+
+    Serial.begin(115200);
+
+    sess_init(nullptr, 0);
+    for(uint8_t ch = 0; ch < WAVE_CHANNELS; ch++){wave_init(ch, pins[ch]); wave_select(ch, benchLevel[ch]);}
+
+    //no channel: the cycles of one iteration follow from the millis interrupt alone
+    uint32_t counts[WAVE_CHANNELS + 1];
+    counts[0] = spin();
+    for(uint8_t ch = 0; ch < WAVE_CHANNELS; ch++){
+        sess_start(ch, RUN_MS / 1000 * (WAVE_CHANNELS + 1));
+        wave_start(ch);
+        counts[ch + 1] = spin();
+    }
+    for(uint8_t ch = 0; ch < WAVE_CHANNELS; ch++){sess_stop(ch); wave_stop(ch);}
+
+    //cycles per iteration, and cycles per ms taken from the loop by n channels
+    float cyclesPerIter = (float)F_CPU / 1000 * RUN_MS / counts[0];
+    Serial.print(F("idle loop: "));
+    Serial.print(cyclesPerIter);
+    Serial.println(F(" cycles per iteration"));
+    for(uint8_t n = 1; n <= WAVE_CHANNELS; n++){
+        float perMs = (float)(counts[0] - counts[n]) * cyclesPerIter / RUN_MS;
+        float added = (float)(counts[n - 1] - counts[n]) * cyclesPerIter / RUN_MS;
+        Serial.print(n);
+        Serial.print(wave_hardware(n - 1) ? F(" channels (last one hardware PWM): ") : F(" channels (last one software PWM): "));
+        Serial.print(perMs);
+        Serial.print(F(" cycles/ms, this channel "));
+        Serial.print(added);
+        Serial.println(F(" cycles/ms"));
+    }
+
+    //simavr quits when the MCU sleeps with interrupts off
+    Serial.flush();
+    cli();
+    sleep_cpu();
+}
+
+void loop(){}
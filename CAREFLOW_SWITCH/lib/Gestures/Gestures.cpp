@@ -0,0 +1,124 @@
+#include "Gestures.h"
+
+#define GEST_TICKS(ms) ((ms) / GEST_TICK_MS)
+
+enum gestState{
+    GS_IDLE,                    //up, no gesture going on
+    GS_DOWN,                    //pressed, counting the hold time
+    GS_UP,                      //released, waiting for the next press of a multi press
+    GS_HELD                     //long press or chord reported, waiting for the release
+};
+
+struct GestButton{
+    uint8_t port;               //bank port of the pin
+    uint8_t bit;                //bit of the pin in its port
+    uint8_t state;              //one of gestState
+    uint8_t count;              //presses of the current gesture
+    uint8_t ticks;              //ticks spent in the current state, saturates at 255
+    uint8_t gesture;            //recognized gesture not read yet
+};
+
+struct GestChord{
+    uint8_t a, b;               //the two buttons
+    bool pressed;               //chord recognized and not read yet
+};
+
+static GestButton _Btn[GEST_MAX];
+static GestChord _Chord[GEST_CHORDS];
+static uint8_t _BtnCnt;
+static uint8_t _ChordCnt;
+
+//follows the gestures of a button pin (registered with the bank already), returns its index
+uint8_t gest_add(uint8_t pin){
+
+    if(_BtnCnt == GEST_MAX){return GEST_MAX - 1;}
+    GestButton *g = &_Btn[_BtnCnt];
+    g->port = bank_port(pin);
+    g->bit = bank_bit(pin);
+    g->state = GS_IDLE;
+    return _BtnCnt++;
+}
+
+//follows the chord of two followed buttons, returns the chord index
+uint8_t gest_chord(uint8_t a, uint8_t b){
+
+    if(_ChordCnt == GEST_CHORDS){return GEST_CHORDS - 1;}
+    _Chord[_ChordCnt].a = a;
+    _Chord[_ChordCnt].b = b;
+    return _ChordCnt++;
+}
+
+//one recognition step, every GEST_TICK_MS - a fixed amount of work per button and chord
+void gest_tick(){
+
+    for(uint8_t i = 0; i < _BtnCnt; i++){
+
+        GestButton *g = &_Btn[i];
+        bool down = bank_down(g->port) & g->bit;
+        if(g->ticks < 0xFF){g->ticks++;}
+
+        switch(g->state){
+            case GS_IDLE:
+                if(down){g->state = GS_DOWN; g->count = 1; g->ticks = 0;}
+                break;
+            case GS_DOWN:
+                if(!down){
+                    //the third press ends the gesture right away, nothing longer is recognized
+                    if(g->count == 3){g->gesture = GESTURE_TRIPLE; g->state = GS_IDLE;}
+                    else{g->state = GS_UP; g->ticks = 0;}
+                }
+                else if(g->count == 1 && g->ticks >= GEST_TICKS(GEST_LONG_MS)){g->gesture = GESTURE_LONG; g->state = GS_HELD;}
+                break;
+            case GS_UP:
+                if(down){g->state = GS_DOWN; g->count++; g->ticks = 0;}
+                else if(g->ticks >= GEST_TICKS(GEST_MULTI_MS)){g->gesture = g->count == 1 ? GESTURE_SINGLE : GESTURE_DOUBLE; g->state = GS_IDLE;}
+                break;
+            case GS_HELD:
+                if(!down){g->state = GS_IDLE;}
+                break;
+        }
+    }
+
+    //a chord is two first presses close together, both buttons are then held so they make no other gesture
+    for(uint8_t c = 0; c < _ChordCnt; c++){
+
+        GestButton *a = &_Btn[_Chord[c].a];
+        GestButton *b = &_Btn[_Chord[c].b];
+        if(a->state == GS_DOWN && b->state == GS_DOWN && a->count == 1 && b->count == 1 &&
+                (a->ticks > b->ticks ? a->ticks - b->ticks : b->ticks - a->ticks) <= GEST_TICKS(GEST_CHORD_MS)){
+            a->state = GS_HELD;
+            b->state = GS_HELD;
+            _Chord[c].pressed = true;
+        }
+    }
+}
+
+//takes the gesture recognized on the button, GESTURE_NONE when there is none
+uint8_t gest_read(uint8_t button){
+
+    uint8_t gesture = _Btn[button].gesture;
+    _Btn[button].gesture = GESTURE_NONE;
+    return gesture;
+}
+
+//takes the chord, true when it was pressed
+bool gest_readChord(uint8_t chord){
+
+    bool pressed = _Chord[chord].pressed;
+    _Chord[chord].pressed = false;
+    return pressed;
+}
+
+//true from a long press or chord until the button is released
+bool gest_held(uint8_t button){return _Btn[button].state == GS_HELD;}
+
+//drops every recognized gesture not read yet and the ones in progress, a button still down is held until released
+void gest_clear(){
+
+    for(uint8_t i = 0; i < _BtnCnt; i++){
+        GestButton *g = &_Btn[i];
+        g->gesture = GESTURE_NONE;
+        g->state = (bank_down(g->port) & g->bit) ? GS_HELD : GS_IDLE;
+    }
+    for(uint8_t c = 0; c < _ChordCnt; c++){_Chord[c].pressed = false;}
+}
@@ -0,0 +1,40 @@
+#ifndef GESTURES_H
+#define GESTURES_H
+
+#include <Arduino.h>
+#include <ButtonBank.h>
+
+#define GEST_MAX 4              //most buttons followed
+#define GEST_CHORDS 2           //most two button chords
+#define GEST_TICK_MS 10         //period gest_tick() is called with
+#define GEST_MULTI_MS 400       //a press starting sooner than this after the last release counts to the same gesture
+#define GEST_LONG_MS 800        //a first press held this long is a long press
+#define GEST_CHORD_MS 100       //most time between the two presses of a chord
+
+/* |
+* @brief button gestures - single, double and triple presses, long presses and two button chords, recognized
+*        from the ButtonBank debounced state by one state machine step per button and chord every GEST_TICK_MS.
+*        Each button keeps a few bytes of state and at most one recognized gesture until it is read.
+*        A multi press is only known once GEST_MULTI_MS passed without another press, so single presses
+*        are reported that much later. A long press or a chord holds its buttons until they are released,
+*        gest_held() tells so, so their release can be kept from other uses of the buttons.
+*/
+
+enum gestureType{
+    GESTURE_NONE,
+    GESTURE_SINGLE,             //one press
+    GESTURE_DOUBLE,             //two presses within GEST_MULTI_MS
+    GESTURE_TRIPLE,             //three presses within GEST_MULTI_MS
+    GESTURE_LONG,               //first press held for GEST_LONG_MS
+    GESTURE_CHORD               //both buttons of a chord pressed within GEST_CHORD_MS (reported on the chord)
+};
+
+uint8_t gest_add(uint8_t pin);                  //follows the gestures of a button pin (registered with the bank already), returns its index
+uint8_t gest_chord(uint8_t a, uint8_t b);       //follows the chord of two followed buttons, returns the chord index
+void gest_tick();                               //one recognition step, every GEST_TICK_MS
+uint8_t gest_read(uint8_t button);              //takes the gesture recognized on the button, GESTURE_NONE when there is none
+bool gest_readChord(uint8_t chord);             //takes the chord, true when it was pressed
+bool gest_held(uint8_t button);                 //true from a long press or chord until the button is released
+void gest_clear();                              //drops every recognized gesture not read yet and the ones in progress
+
+#endif
@@ -0,0 +1,63 @@
+#include "LcdGlyphs.h"
+
+//Initializer. Requires the display and the PROGMEM glyph table
+LcdGlyphs::LcdGlyphs(LcdShadow &lcd, const uint8_t (*table)[8]) : _Lcd(lcd), _Table(table) {reset();}
+
+//forgets the slot contents - slot 0 is the least recently used so the first uploads fill the slots in order
+void LcdGlyphs::reset(){
+    for(uint8_t i = 0; i < LCDGLYPHS_SLOTS; i++){_Slot[i] = LCDGLYPHS_NONE; _Order[i] = LCDGLYPHS_SLOTS - 1 - i;}
+}
+
+//slot holding the glyph, -1 if not loaded
+int8_t LcdGlyphs::find(uint8_t glyph){
+    for(uint8_t i = 0; i < LCDGLYPHS_SLOTS; i++){if(_Slot[i] == glyph){return i;}}
+    return -1;
+}
+
+//marks the slot as most recently used
+void LcdGlyphs::touch(uint8_t slot){
+    uint8_t i = 0;
+    while(_Order[i] != slot){i++;}
+    for(; i > 0; i--){_Order[i] = _Order[i - 1];}
+    _Order[0] = slot;
+}
+
+//makes sure the glyphs are loaded - anything past the slot count is ignored
+void LcdGlyphs::load(const uint8_t *glyphs, uint8_t count){
+
+    if(count > LCDGLYPHS_SLOTS){count = LCDGLYPHS_SLOTS;}
+
+    //the loaded ones move to the front first, so no glyph of this request can be evicted below
+    for(uint8_t i = 0; i < count; i++){
+        int8_t slot = find(glyphs[i]);
+        if(slot >= 0){touch(slot);}
+    }
+
+    //the missing ones take over the least recently used slots
+    uint8_t upload[LCDGLYPHS_SLOTS];
+    memset(upload, LCDGLYPHS_NONE, sizeof upload);
+    for(uint8_t i = 0; i < count; i++){
+        if(find(glyphs[i]) >= 0){continue;}
+        uint8_t slot = _Order[LCDGLYPHS_SLOTS - 1];
+        _Slot[slot] = glyphs[i];
+        upload[slot] = glyphs[i];
+        touch(slot);
+    }
+
+    //one address command and one data burst per run of consecutive slots
+    for(uint8_t start = 0; start < LCDGLYPHS_SLOTS; start++){
+        if(upload[start] == LCDGLYPHS_NONE){continue;}
+        uint8_t end = start + 1;
+        while(end < LCDGLYPHS_SLOTS && upload[end] != LCDGLYPHS_NONE){end++;}
+        _Lcd.createChars_P(start, _Table, &upload[start], end - start);
+        start = end;
+    }
+}
+
+//character code to print the glyph with, loads it if needed
+uint8_t LcdGlyphs::code(uint8_t glyph){
+    int8_t slot = find(glyph);
+    if(slot < 0){load(&glyph, 1); slot = find(glyph);}
+    else{touch(slot);}
+    return slot;
+}
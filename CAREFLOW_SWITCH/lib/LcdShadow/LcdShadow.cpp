@@ -0,0 +1,141 @@
+#include "LcdShadow.h"
+
+//Initializer. Required the display to draw on
+LcdShadow::LcdShadow(LcdI2C &lcd) : _Lcd(lcd){
+    _Col = 0;
+    _Row = 0;
+    _HwCol = 0xFF;
+    _HwRow = 0;
+    _NoteHead = 0;
+    _NoteCnt = 0;
+    _NoteOn = false;
+}
+
+//initializes the display and both frames to blank
+void LcdShadow::init(){
+    _Lcd.init();
+
+    //init() leaves the display cleared with the cursor at home
+    memset(_Back, ' ', sizeof _Back);
+    memset(_Front, ' ', sizeof _Front);
+    _Col = 0; _Row = 0;
+    _HwCol = 0; _HwRow = 0;
+}
+
+//switches the backlight on
+void LcdShadow::backlight(){_Lcd.backlight();}
+
+//switches the backlight off
+void LcdShadow::noBacklight(){_Lcd.noBacklight();}
+
+//loads a custom character into the display - leaves the display address in CGRAM so the cursor is lost
+void LcdShadow::createChar(uint8_t location, uint8_t charmap[]){_Lcd.createChar(location, charmap); _HwCol = 0xFF;}
+
+//loads PROGMEM characters into consecutive slots as one burst - same as createChar the cursor is lost
+void LcdShadow::createChars_P(uint8_t location, const uint8_t (*table)[8], const uint8_t *glyphs, uint8_t count){
+    _Lcd.createChars_P(location, table, glyphs, count);
+    _HwCol = 0xFF;
+}
+
+//blanks the frame being composed (display is untouched until commit)
+void LcdShadow::clear(){memset(_Back, ' ', sizeof _Back); _Col = 0; _Row = 0;}
+
+//sets the position of the next write into the frame
+void LcdShadow::setCursor(uint8_t col, uint8_t row){_Col = col; _Row = row;}
+
+//writes a single character into the frame - anything outside the visible area is dropped
+size_t LcdShadow::write(uint8_t c){
+    if(_Row < LCDSHADOW_ROWS && _Col < LCDSHADOW_COLS){_Back[_Row][_Col] = c;}
+    if(_Col < 0xFF){_Col++;}
+    return 1;
+}
+
+//writes a run of characters into the frame
+size_t LcdShadow::write(const uint8_t *buffer, size_t size){
+    for(size_t i = 0; i < size; i++){write(buffer[i]);}
+    return size;
+}
+
+//moves the display cursor and tracks it
+void LcdShadow::hwSetCursor(uint8_t col, uint8_t row){_Lcd.setCursor(col, row); _HwCol = col; _HwRow = row;}
+
+//queues a timed message of PROGMEM lines, false when the queue is full
+bool LcdShadow::notify(const char *line0, const char *line1, uint16_t ms){
+
+    if(_NoteCnt == LCDSHADOW_NOTES){return false;}
+    LcdNote *n = &_Notes[(_NoteHead + _NoteCnt) & (LCDSHADOW_NOTES - 1)];
+    n->line0 = line0;
+    n->line1 = line1;
+    n->ms = ms;
+    _NoteCnt++;
+    return true;
+}
+
+//true while a notification shows or waits
+bool LcdShadow::notifying(){return _NoteCnt > 0;}
+
+//centres a PROGMEM line into the notification frame
+void LcdShadow::overLine(uint8_t row, const char *text){
+
+    memset(_Over[row], ' ', LCDSHADOW_COLS);
+    if(!text){return;}
+    uint8_t len = strlen_P(text);
+    if(len > LCDSHADOW_COLS){len = LCDSHADOW_COLS;}
+    memcpy_P(&_Over[row][(LCDSHADOW_COLS - len) / 2], text, len);
+}
+
+//sends the changed cells as runs (one burst per run), returns number of bytes sent to the display
+uint8_t LcdShadow::commit(){
+
+    uint8_t sent = 0;
+
+    //take the expired notification down and put the next one up, the page comes back when none is left
+    uint16_t now = millis();
+    if(_NoteOn && (uint16_t)(now - _NoteMs) >= _Notes[_NoteHead].ms){
+        _NoteHead = (_NoteHead + 1) & (LCDSHADOW_NOTES - 1);
+        _NoteCnt--;
+        _NoteOn = false;
+    }
+    if(!_NoteOn && _NoteCnt > 0){
+        overLine(0, _Notes[_NoteHead].line0);
+        overLine(1, _Notes[_NoteHead].line1);
+        _NoteMs = now;
+        _NoteOn = true;
+    }
+    uint8_t (*frame)[LCDSHADOW_COLS] = _NoteOn ? _Over : _Back;
+
+    for(uint8_t row = 0; row < LCDSHADOW_ROWS; row++){
+
+        //the display address does not wrap onto the next row, so a new row always needs a cursor move
+        if(_HwRow != row){_HwCol = 0xFF;}
+
+        uint8_t col = 0;
+        while(col < LCDSHADOW_COLS){
+
+            //nothing to do if the cell already shows the right character
+            if(frame[row][col] == _Front[row][col]){col++; continue;}
+
+            //short gap since the last cell sent -> re-send the unchanged cells instead of moving the cursor
+            uint8_t start = col;
+            if(_HwCol != 0xFF && _HwCol < col && col - _HwCol <= LCDSHADOW_GAP_BRIDGE){start = _HwCol;}
+
+            //otherwise move the cursor when it is not already in place
+            else if(_HwCol != col){hwSetCursor(col, row); sent++;}
+
+            //grow the run over the following changed cells, bridging short gaps of unchanged ones
+            uint8_t end = col + 1;
+            for(uint8_t i = end; i < LCDSHADOW_COLS && i - end < LCDSHADOW_GAP_BRIDGE + 1; i++){
+                if(frame[row][i] != _Front[row][i]){end = i + 1;}
+            }
+
+            //send the run and take note of what the display now shows
+            _Lcd.write(&frame[row][start], end - start);
+            memcpy(&_Front[row][start], &frame[row][start], end - start);
+            sent += end - start;
+            _HwCol = end;
+            col = end;
+        }
+    }
+
+    return sent;
+}
@@ -0,0 +1,66 @@
+#ifndef LCDSHADOW_H
+#define LCDSHADOW_H
+
+#include <Arduino.h>
+#include <LcdI2C.h>
+
+#define LCDSHADOW_COLS 16       //number of characters in a single row of the display
+#define LCDSHADOW_ROWS 2        //number of rows of the display
+#define LCDSHADOW_GAP_BRIDGE 1  //max unchanged cells re-sent to join two changed runs (a cursor move costs one byte too)
+#define LCDSHADOW_NOTES 4       //notifications that can wait to be shown, must be a power of 2
+
+/* |
+* @brief RAM shadow of the display - print/setCursor only write into RAM,
+*        commit() sends the cells that changed since the last commit.
+*        notify() queues a timed two line message: while it shows, commit() sends the message frame
+*        and the page keeps drawing underneath, when it expires the page is back with the next commit
+*/
+
+//a queued notification - two PROGMEM lines, centred, and how long they show
+struct LcdNote{
+    const char *line0;          //PROGMEM top line, nullptr for a blank line
+    const char *line1;          //PROGMEM bottom line, nullptr for a blank line
+    uint16_t ms;                //time on the display
+};
+
+class LcdShadow : public Print {
+
+private:
+
+    LcdI2C &_Lcd;                                       //the real display
+    uint8_t _Back[LCDSHADOW_ROWS][LCDSHADOW_COLS];      //frame being composed by print/setCursor
+    uint8_t _Front[LCDSHADOW_ROWS][LCDSHADOW_COLS];     //what the display is currently showing
+    uint8_t _Col;                                       //shadow cursor column
+    uint8_t _Row;                                       //shadow cursor row
+    uint8_t _HwCol;                                     //display cursor column, 0xFF when unknown
+    uint8_t _HwRow;                                     //display cursor row
+    uint8_t _Over[LCDSHADOW_ROWS][LCDSHADOW_COLS];      //frame of the notification showing
+    LcdNote _Notes[LCDSHADOW_NOTES];                    //notifications waiting, the head one is showing when _NoteOn
+    uint8_t _NoteHead;                                  //oldest notification
+    uint8_t _NoteCnt;                                   //notifications queued
+    bool _NoteOn;                                       //true while the head notification is in _Over
+    uint16_t _NoteMs;                                   //when the head notification went up, low 16 bits of millis()
+
+    void hwSetCursor(uint8_t col, uint8_t row);         //moves the display cursor and tracks it
+    void overLine(uint8_t row, const char *text);       //centres a PROGMEM line into the notification frame
+
+public:
+
+    LcdShadow(LcdI2C &lcd);                             //Initializer. Required the display to draw on
+    void init();                                        //initializes the display and both frames to blank
+    void backlight();                                   //switches the backlight on
+    void noBacklight();                                 //switches the backlight off
+    void createChar(uint8_t location, uint8_t charmap[]);   //loads a custom character into the display
+    void createChars_P(uint8_t location, const uint8_t (*table)[8], const uint8_t *glyphs, uint8_t count);  //loads PROGMEM characters into consecutive slots
+    void clear();                                       //blanks the frame being composed (display is untouched until commit)
+    void setCursor(uint8_t col, uint8_t row);           //sets the position of the next write into the frame
+    virtual size_t write(uint8_t c);                    //writes a single character into the frame
+    virtual size_t write(const uint8_t *buffer, size_t size);  //writes a run of characters into the frame
+    using Print::write;
+    bool notify(const char *line0, const char *line1, uint16_t ms);    //queues a timed message of PROGMEM lines, false when the queue is full
+    bool notifying();                                   //true while a notification shows or waits
+    uint8_t commit();                                   //sends the changed cells as runs, returns number of bytes sent to the display
+
+};
+
+#endif
@@ -0,0 +1,68 @@
+#include "NumFmt.h"
+
+// the places above 10^4 are done in 32 bits, what is left then always fits in 16 bits
+static const uint32_t Pow10_32[] PROGMEM = {1000000000UL, 100000000UL, 10000000UL, 1000000UL, 100000UL, 10000UL};
+static const uint16_t Pow10_16[] PROGMEM = {10000, 1000, 100, 10};
+
+//appends the digits of value from the place Pow10_16[first] down, leading zeros are skipped while n is 0
+static uint8_t digits16(char *d, uint8_t n, uint16_t value, uint8_t first){
+
+    for(uint8_t i = first; i < sizeof(Pow10_16) / sizeof(Pow10_16[0]); i++){
+
+        uint16_t p = pgm_read_word(&Pow10_16[i]);
+        char c = '0';
+        while(value >= p){value -= p; c++;}
+        if(n || c != '0'){d[n++] = c;}
+    }
+
+    //the units are what is left
+    d[n++] = '0' + value;
+    return n;
+}
+
+//copies the digits into buf with the fill characters on the requested side
+static uint8_t field(char *buf, const char *d, uint8_t cnt, uint8_t width, char fill, bool isRight){
+
+    uint8_t pad = width > cnt ? width - cnt : 0;
+
+    if(isRight){memset(buf, fill, pad); memcpy(buf + pad, d, cnt);}
+    else{memcpy(buf, d, cnt); memset(buf + cnt, fill, pad);}
+
+    return cnt + pad;
+}
+
+//formats the value into buf, returns the field length
+uint8_t numfmt_u8(char *buf, uint8_t value, uint8_t width, char fill, bool isRight){
+
+    char d[3];
+    return field(buf, d, digits16(d, 0, value, 2), width, fill, isRight);
+}
+
+//same for a uint16_t
+uint8_t numfmt_u16(char *buf, uint16_t value, uint8_t width, char fill, bool isRight){
+
+    if(value <= 0xFF){return numfmt_u8(buf, value, width, fill, isRight);}
+
+    char d[5];
+    return field(buf, d, digits16(d, 0, value, 0), width, fill, isRight);
+}
+
+//same for a uint32_t
+uint8_t numfmt_u32(char *buf, uint32_t value, uint8_t width, char fill, bool isRight){
+
+    //smaller values skip the 32 bit places altogether
+    if(value <= 0xFFFF){return numfmt_u16(buf, value, width, fill, isRight);}
+
+    char d[NUMFMT_U32_DIGITS];
+    uint8_t n = 0;
+
+    for(uint8_t i = 0; i < sizeof(Pow10_32) / sizeof(Pow10_32[0]); i++){
+
+        uint32_t p = pgm_read_dword(&Pow10_32[i]);
+        char c = '0';
+        while(value >= p){value -= p; c++;}
+        if(n || c != '0'){d[n++] = c;}
+    }
+
+    return field(buf, d, digits16(d, n, value, 1), width, fill, isRight);
+}
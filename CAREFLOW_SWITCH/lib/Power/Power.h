@@ -0,0 +1,20 @@
+#ifndef POWER_H
+#define POWER_H
+
+#include <Arduino.h>
+
+/* |
+* @brief MCU sleep helpers - idle between scheduler passes and power down until a button press.
+*        Idle keeps every clock running, so the millis tick (about every 1ms), the TWI queue and
+*        any other interrupt wake it. Power down stops all clocks (millis does not advance) and
+*        only a level change on one of the given pins, through its pin change interrupt, wakes it.
+*        The pin change vectors are ButtonBank's, so the wake pins are bank buttons. The pin change
+*        masks in use before are restored on wake up.
+*        Built with PWR_AWAKE, pwr_idle() returns at once and the sketch never powers down - the same firmware
+*        without sleeping, for measuring the current saved (a meter in series with VIN).
+*/
+
+void pwr_idle();                                        //sleeps until the next interrupt
+void pwr_powerDown(const uint8_t *pins, uint8_t count); //powers down until one of the pins changes, ADC off meanwhile
+
+#endif
@@ -1,59 +1,79 @@
 #include "Pressbutton.h"
 
-//Initializer for button. Required the pin value
-PressButton::PressButton(int pin){
-    _IoPin = pin;
-    pinMode(_IoPin, INPUT_PULLUP);
+uint8_t PressButtonBase::_Cnt;
+uint8_t PressButtonBase::_WasDown[BANK_PORTS];
+uint8_t PressButtonBase::_RepeatCnt[PRESSBUTTON_MAX];
+uint16_t PressButtonBase::_LasRepeatMs[PRESSBUTTON_MAX];
+uint8_t PressButtonBase::_Stamped[BANK_PORTS];
+uint8_t PressButtonBase::_IdxOf[BANK_PINS];
 
+//450ms after the first trigger, 50ms less after each following one, 200ms from the 6th on
+const RepeatProfile repeatDefault PROGMEM = {7, {{0, 1}, {450, 1}, {400, 1}, {350, 1}, {300, 1}, {250, 1}, {200, 1}}};
 
-}    
-
-//returns the IO pin the button is configured to use
-int PressButton::GetIOPin(){return _IoPin;}             
-
-//does a debounced check to see if the specified button is in the down state
-boolean PressButton::IsDown(){return digitalRead(_IoPin)== LOW && digitalRead(_IoPin) == LOW;}  
-
-//does debounced check to see if specified button is in the up state
-boolean PressButton::IsUp(){return digitalRead(_IoPin) == HIGH && digitalRead(_IoPin) == HIGH;}
+//a few single steps for fine setting, then the step grows (intervals are multiples of the 25ms menu step)
+const RepeatProfile repeatFast8 PROGMEM = {7, {{0, 1}, {400, 1}, {150, 1}, {100, 1}, {75, 2}, {50, 4}, {50, 8}}};
+const RepeatProfile repeatFast16 PROGMEM = {8, {{0, 1}, {400, 1}, {150, 1}, {100, 2}, {75, 10}, {50, 100}, {50, 500}, {50, 2000}}};
 
-// will set the WasDown flag true if was pressed when checked - also returns WasDown state at the same time 
-boolean PressButton::CaptureDownState(){if(IsDown()){WasDown = true;} return WasDown;}
-
-//clears the was down state, returns true if clear was done
-boolean PressButton::ClearWasDown(){if(WasDown){WasDown = false; return true;} return false;} 
-
-//provides a trigger action if the button was pressed but is now released > Clears WasDown
-boolean PressButton::PressReleased(){if (WasDown && IsUp()){RepeatCnt = 0; WasDown = false; return true;} return false;}  
+//registers the pin with the bank and takes a table index
+PressButtonBase::PressButtonBase(uint8_t pin){
+    uint8_t slot = bank_add(pin);
+    _Idx = _Cnt < PRESSBUTTON_MAX - 1 ? _Cnt++ : PRESSBUTTON_MAX - 1;
+    _IdxOf[slot] = _Idx;
+}    
 
- //provides trigger for long press case 
-boolean PressButton::LongPressed(){return(Repeated() && RepeatCnt == 2);}
+//number of times repeat trigger sent since the press, 0 when not repeating
+uint8_t PressButtonBase::RepeatCnt(){return _RepeatCnt[_Idx];}
 
-//Provides and action trigger at a increasingly higher frequency for as long as a key is pressed
-boolean PressButton::Repeated(){
+//Repeated() of the button on that port bit - provides and action trigger at a increasingly higher frequency for as long as a key is pressed,
+//returns the step size of the profile stage or 0 when there is no trigger
+uint16_t PressButtonBase::repeated(uint8_t port, uint8_t bit, const RepeatProfile *profile){
     //snapshot the current time
-    uint32_t currMs = millis();
+    uint16_t currMs = millis();
+    uint8_t cnt = _RepeatCnt[_Idx];
 
-    //check if repeat signal should be sent
-    if (WasDown && (
-                        RepeatCnt == 0 ||                                       
-                        (RepeatCnt > 5 && currMs >= (LasRepeatMs + 200)) ||     
-                        currMs >= (LasRepeatMs + 250 + (50 * (5- RepeatCnt)))
-                    )){
+    //the stage of this trigger, the last one keeps repeating
+    uint8_t last = pgm_read_byte(&profile->count) - 1;
+    const RepeatStage *stage = &profile->stages[cnt < last ? cnt : last];
 
-        //increase the repeat count limiting to mac value 999 to avoid roll over
-        if (RepeatCnt < 999 ){RepeatCnt += 1;}
+    //check if repeat signal should be sent (the elapsed time is wrap safe, intervals are far below 65s)
+    if ((_WasDown[port] & bit) && (cnt == 0 || (uint16_t)(currMs - _LasRepeatMs[_Idx]) >= pgm_read_word(&stage->intervalMs))){
+
+        //increase the repeat count limiting to max value 255 to avoid roll over
+        if (cnt < 0xFF){_RepeatCnt[_Idx] = cnt + 1;}
         //clear the was down state to get the next repeat
-        WasDown = false;
-        //take note of the last repeat time to be used n next comparison & send back a positive trigger
-        LasRepeatMs = currMs;
+        _WasDown[port] &= ~bit;
+        //take note of the last repeat time to be used n next comparison, the first trigger counts from the press edge when it has one
+        if(cnt > 0 || !(_Stamped[port] & bit)){_LasRepeatMs[_Idx] = currMs;}
+        _Stamped[port] &= ~bit;
         //send back positive trigger
-        return true;
+        return pgm_read_word(&stage->step);
     }
     //otherwise
     else{
         //has repeated and button is now up, then clear the repeat count and was down state
-        if (RepeatCnt > 0  && IsUp()){RepeatCnt = 0; WasDown = false;}
+        if (cnt > 0  && !(bank_down(port) & bit)){_RepeatCnt[_Idx] = 0; _WasDown[port] &= ~bit;}
         //send back a negative trigger
-        return false;}
-}         
+        return 0;}
+}
+
+//takes the bank events in order and sets WasDown of every button pressed since the last call, returns true if there was any press -
+//a release needs nothing, PressReleased() sees the debounced up state
+boolean PressButtonBase::Dispatch(){
+
+    bool pressed = false;
+    BankEvent e;
+    while(bank_takeEvent(&e)){
+        if(!(e.code & BANK_DOWN)){continue;}
+
+        uint8_t slot = e.code & ~BANK_DOWN;
+        uint8_t port = bank_slotPort(slot);
+        uint8_t bit = bank_slotBit(slot);
+        _WasDown[port] |= bit;
+
+        //a button not repeating yet times its repeats from this press
+        uint8_t idx = _IdxOf[slot];
+        if(_RepeatCnt[idx] == 0){_LasRepeatMs[idx] = e.ms; _Stamped[port] |= bit;}
+        pressed = true;
+    }
+    return pressed;
+}
@@ -0,0 +1,148 @@
+#include "Session.h"
+#include <avr/interrupt.h>
+#include <util/atomic.h>
+
+static volatile uint8_t *_Out[SESS_MAX_OUTPUTS];    //output register of each indicator pin
+static uint8_t _Bit[SESS_MAX_OUTPUTS];              //bit of each indicator pin
+static uint8_t _OutCnt;
+static void (*_OnOutputs)(uint8_t ch, bool on);     //called whenever the outputs of a channel switch
+
+static volatile uint8_t _State[SESS_CHANNELS];
+static volatile uint32_t _RemainingMs[SESS_CHANNELS];
+static volatile uint16_t _MsToSecond[SESS_CHANNELS];    //ms until the remaining time is a whole second again
+static volatile uint16_t _RemainingS[SESS_CHANNELS];    //whole seconds left, rounded up
+static volatile uint8_t _Running;                   //bit per channel counting down
+static volatile uint8_t _Second;                    //bit per channel that passed a whole second
+
+//outputs of the channel on or off, the indicators and the tick follow the running channels - interrupts must be off
+static void outputs(uint8_t ch, bool on){
+
+    uint8_t was = _Running;
+    if(on){_Running = was | _BV(ch);} else{_Running = was & ~_BV(ch);}
+
+    //the tick only runs while a session is counting, a pending tick is kept for the channels running already
+    if(!was && _Running){TIFR1 = _BV(OCF1A); TIMSK1 |= _BV(OCIE1A);}
+    else if(was && !_Running){TIMSK1 &= ~_BV(OCIE1A);}
+
+    for(uint8_t i = 0; i < _OutCnt; i++){if(_Running){*_Out[i] |= _Bit[i];} else{*_Out[i] &= ~_Bit[i];}}
+    if(_OnOutputs){_OnOutputs(ch, on);}
+}
+
+//1ms tick of the running sessions, only the running channels cost anything
+ISR(TIMER1_COMPA_vect){
+
+    uint8_t running = _Running;
+    for(uint8_t ch = 0; running; ch++, running >>= 1){
+
+        if(!(running & 1)){continue;}
+
+        uint16_t toSecond = _MsToSecond[ch] - 1;
+        if(toSecond == 0){toSecond = 1000; _Second |= _BV(ch); _RemainingS[ch]--;}
+        _MsToSecond[ch] = toSecond;
+
+        uint32_t ms = _RemainingMs[ch] - 1;
+        _RemainingMs[ch] = ms;
+        if(ms == 0){
+            outputs(ch, false);
+            _State[ch] = SESS_COMPLETE;
+            _Second |= _BV(ch);
+        }
+    }
+}
+
+//sets the indicator pins, on while any channel runs, and starts the 1ms frame
+void sess_init(const uint8_t *pins, uint8_t count){
+
+    for(uint8_t i = 0; i < count && i < SESS_MAX_OUTPUTS; i++){
+        pinMode(pins[i], OUTPUT);
+        digitalWrite(pins[i], LOW);
+        _Out[i] = portOutputRegister(digitalPinToPort(pins[i]));
+        _Bit[i] = digitalPinToBitMask(pins[i]);
+        _OutCnt = i + 1;
+    }
+
+    //CTC at 1kHz: 16MHz / 64 / 250
+    TCCR1A = 0;
+    TCCR1B = _BV(WGM12) | _BV(CS11) | _BV(CS10);
+    OCR1A = F_CPU / 64 / 1000 - 1;
+}
+
+//also calls fn whenever the outputs of a channel switch, from the timer interrupt at the end tick
+void sess_onOutputs(void (*fn)(uint8_t ch, bool on)){_OnOutputs = fn;}
+
+//starts a session of the given length in seconds on the channel, outputs on
+void sess_start(uint8_t ch, uint16_t durationS){
+
+    if(durationS == 0 || ch >= SESS_CHANNELS){return;}
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+        _RemainingMs[ch] = (uint32_t)durationS * 1000;
+        _RemainingS[ch] = durationS;
+        _MsToSecond[ch] = 1000;
+        _Second |= _BV(ch);
+        _State[ch] = SESS_RUNNING;
+        outputs(ch, true);
+    }
+}
+
+//stops the count of the running session, outputs off
+void sess_pause(uint8_t ch){
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+        if(ch >= SESS_CHANNELS || _State[ch] != SESS_RUNNING){return;}
+        outputs(ch, false);
+        _State[ch] = SESS_PAUSED;
+    }
+}
+
+//continues the paused session, outputs on
+void sess_resume(uint8_t ch){
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+        if(ch >= SESS_CHANNELS || _State[ch] != SESS_PAUSED){return;}
+        _State[ch] = SESS_RUNNING;
+        _Second |= _BV(ch);
+        outputs(ch, true);
+    }
+}
+
+//ends the session whatever its state, outputs off, back to idle
+void sess_stop(uint8_t ch){
+
+    if(ch >= SESS_CHANNELS){return;}
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+        outputs(ch, false);
+        _RemainingMs[ch] = 0;
+        _RemainingS[ch] = 0;
+        _State[ch] = SESS_IDLE;
+    }
+}
+
+//one of sessState
+uint8_t sess_state(uint8_t ch){return ch < SESS_CHANNELS ? _State[ch] : (uint8_t)SESS_IDLE;}
+
+//bit per running channel, 0 when none runs
+uint8_t sess_running(){return _Running;}
+
+//time left of the session
+uint32_t sess_remainingMs(uint8_t ch){
+
+    uint32_t ms = 0;
+    if(ch < SESS_CHANNELS){ATOMIC_BLOCK(ATOMIC_RESTORESTATE){ms = _RemainingMs[ch];}}
+    return ms;
+}
+
+//whole seconds left of the session, rounded up
+uint16_t sess_remainingS(uint8_t ch){
+
+    uint16_t s = 0;
+    if(ch < SESS_CHANNELS){ATOMIC_BLOCK(ATOMIC_RESTORESTATE){s = _RemainingS[ch];}}
+    return s;
+}
+
+//true once per whole second passed since the last call
+bool sess_takeSecond(uint8_t ch){
+
+    bool second = false;
+    if(ch < SESS_CHANNELS){ATOMIC_BLOCK(ATOMIC_RESTORESTATE){second = _Second & _BV(ch); _Second &= ~_BV(ch);}}
+    return second;
+}
@@ -0,0 +1,40 @@
+#ifndef SESSION_H
+#define SESSION_H
+
+#include <Arduino.h>
+
+#define SESS_CHANNELS 4         //independent sessions, one per output channel
+#define SESS_MAX_OUTPUTS 4      //most indicator pins
+
+/* |
+* @brief timed sessions - a Timer1 compare interrupt every 1ms counts the remaining time of every running
+*        channel down and switches the channel off on the tick its time runs out, whatever the main loop is
+*        busy with. Each channel has its own session: started, paused and stopped on its own, pausing stops
+*        its count so pause and resume lose no time. The outputs of a channel follow through the
+*        sess_onOutputs() callback, the indicator pins are on while any channel runs.
+*        Sessions are set in whole seconds, the whole seconds left are counted along with the ms so neither
+*        needs a division. Every whole second of remaining time passed is flagged per channel for sess_takeSecond().
+*        Owns Timer1 (the PWM of pins 9 and 10 is not available while it runs), the counter keeps running
+*        in its 1ms frame when no session does, Waveform switches its software PWM channels in that frame.
+*/
+
+enum sessState{
+    SESS_IDLE,                  //no session
+    SESS_RUNNING,               //counting down, outputs on
+    SESS_PAUSED,                //count stopped, outputs off
+    SESS_COMPLETE               //time ran out, outputs off until sess_stop()
+};
+
+void sess_init(const uint8_t *pins, uint8_t count);     //sets the indicator pins, on while any channel runs, and starts the 1ms frame
+void sess_onOutputs(void (*fn)(uint8_t ch, bool on));   //also calls fn whenever the outputs of a channel switch, from the timer interrupt at the end tick
+void sess_start(uint8_t ch, uint16_t durationS);        //starts a session of the given length in seconds on the channel, outputs on
+void sess_pause(uint8_t ch);                            //stops the count of the running session, outputs off
+void sess_resume(uint8_t ch);                           //continues the paused session, outputs on
+void sess_stop(uint8_t ch);                             //ends the session whatever its state, outputs off, back to idle
+uint8_t sess_state(uint8_t ch);                         //one of sessState
+uint8_t sess_running();                                 //bit per running channel, 0 when none runs
+uint32_t sess_remainingMs(uint8_t ch);                  //time left of the session
+uint16_t sess_remainingS(uint8_t ch);                   //whole seconds left of the session, rounded up
+bool sess_takeSecond(uint8_t ch);                       //true once per whole second passed since the last call
+
+#endif
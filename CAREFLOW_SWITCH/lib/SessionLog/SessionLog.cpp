@@ -0,0 +1,143 @@
+#include "SessionLog.h"
+#include <avr/eeprom.h>
+
+static_assert(SLOG_SLOTS < 254, "the sequence numbers must be able to tell the head, the tail and a torn record apart");
+static_assert((SLOG_QUEUE & (SLOG_QUEUE - 1)) == 0, "SLOG_QUEUE must be a power of 2");
+
+static uint8_t _Head;                   //slot the next record goes into
+static uint8_t _Count;                  //records in the log, the head slot never counts while it is being written
+static uint8_t _Seq;                    //sequence number of the next record
+
+static uint8_t _Queue[SLOG_QUEUE][SLOG_RECORD];     //records waiting, the sequence byte is set when the write starts
+static uint8_t _QueueHead;              //record being written, or written next
+static uint8_t _QueueCnt;               //records waiting
+static uint8_t _PendingLeft;            //writes of the head record still to do: the old sequence byte voided, the payload, the sequence byte
+
+static bool _Exporting;
+static uint16_t _ExportPos;             //next byte of the export frame
+static uint8_t _ExportSum;              //sum of the bytes sent
+
+#define SLOG_HEADER 5                   //bytes before the records in the export frame
+
+static uint8_t *slot(uint8_t s){return (uint8_t *)(uintptr_t)(SLOG_START + (uint16_t)s * SLOG_RECORD);}
+static uint8_t seqAt(uint8_t s){return eeprom_read_byte(slot(s % SLOG_SLOTS));}
+
+//finds the head of the log - the first slot whose sequence number does not follow the one before
+void slog_init(){
+
+    uint8_t prev = seqAt(0);
+    _Head = 0;
+    _Count = 0;
+    _Seq = 0;
+    if(prev == 0xFF){return;}
+
+    uint8_t s;
+    for(s = 1; s < SLOG_SLOTS; s++){
+        uint8_t seq = seqAt(s);
+        if(seq != (prev + 1) % 255){break;}
+        prev = seq;
+    }
+
+    //a break before an empty slot means the ring has not wrapped yet, a record torn there still reads as empty
+    if(s < SLOG_SLOTS && seqAt(s) == 0xFF){_Head = s; _Count = s; _Seq = (prev + 1) % 255; return;}
+
+    //wrapped - a record torn by a reset holds a voided sequence number that follows neither neighbour, the head
+    //slot is then no record. Slot 0 is that head when it does not follow the last slot
+    uint8_t last = seqAt(SLOG_SLOTS - 1);
+    if(s == 1 && seqAt(0) != (last + 1) % 255){s = 0; prev = last;}
+    _Head = s % SLOG_SLOTS;
+    _Seq = (prev + 1) % 255;
+    _Count = seqAt(_Head + 1) == (seqAt(_Head) + 1) % 255 ? SLOG_SLOTS : SLOG_SLOTS - 1;
+}
+
+//queues a record for writing, false while SLOG_QUEUE records still wait
+bool slog_append(const SlogRecord *r){
+
+    if(_QueueCnt == SLOG_QUEUE){return false;}
+
+    uint16_t plannedS = r->plannedS < SLOG_MAX_PLANNED ? r->plannedS : SLOG_MAX_PLANNED;
+    uint16_t shortS = r->actualS < plannedS ? plannedS - r->actualS : 0;
+    uint8_t *rec = _Queue[(_QueueHead + _QueueCnt) & (SLOG_QUEUE - 1)];
+    rec[1] = (r->mode & 0x03) | ((r->end & 0x03) << 2) | ((r->pauses < 15 ? r->pauses : 15) << 4);
+    rec[2] = plannedS & 0xFF;
+    rec[3] = (plannedS >> 8) | ((r->channel & 0x03) << 6);
+    rec[4] = shortS < 0xFF ? shortS : 0xFF;
+    _QueueCnt++;
+    return true;
+}
+
+//starts sending the log over Serial
+void slog_export(){_Exporting = true; _ExportPos = 0; _ExportSum = 0;}
+
+//byte n of the export frame
+static uint8_t exportByte(uint16_t n){
+
+    switch(n){
+        case 0: return 'S';
+        case 1: return 'L';
+        case 2: return SLOG_VERSION;
+        case 3: return SLOG_RECORD;
+        case 4: return _Count;
+    }
+    n -= SLOG_HEADER;
+    if(n >= (uint16_t)_Count * SLOG_RECORD){return -_ExportSum;}
+
+    //oldest record first - the head slot once the ring has wrapped, the one after it while the head is written or torn
+    uint8_t oldest = (_Head + SLOG_SLOTS - _Count) % SLOG_SLOTS;
+    uint8_t s = (oldest + n / SLOG_RECORD) % SLOG_SLOTS;
+    return eeprom_read_byte(slot(s) + n % SLOG_RECORD);
+}
+
+//writes a queued byte or sends export bytes, never waits - the export goes first, a record written meanwhile waits for it
+void slog_task(){
+
+    if(_Exporting){
+
+        //a read would wait for a write still in progress (settings save)
+        if(!eeprom_is_ready()){return;}
+
+        uint16_t frameLen = SLOG_HEADER + (uint16_t)_Count * SLOG_RECORD + 1;
+        int room = Serial.availableForWrite();
+        while(room-- > 0 && _ExportPos < frameLen){
+            uint8_t b = exportByte(_ExportPos++);
+            _ExportSum += b;
+            Serial.write(b);
+        }
+        if(_ExportPos == frameLen){_Exporting = false;}
+        return;
+    }
+
+    //one byte per call, only when the previous write is done
+    if(!eeprom_is_ready()){return;}
+
+    //the next queued record gets its sequence number when its write starts - the oldest record in the head slot
+    //leaves the log now, and a slot in use first gets a voided sequence number so a reset during the payload
+    //leaves no record with the old number
+    if(!_PendingLeft && _QueueCnt){
+        _Queue[_QueueHead][0] = _Seq;
+        _PendingLeft = SLOG_RECORD;
+        if(eeprom_read_byte(slot(_Head)) != 0xFF){_PendingLeft++;}
+        if(_Count == SLOG_SLOTS){_Count--;}
+    }
+
+    //voided sequence byte, payload, then the sequence byte
+    if(_PendingLeft){
+        _PendingLeft--;
+        if(_PendingLeft == SLOG_RECORD){eeprom_update_byte(slot(_Head), (_Seq + 1) % 255);}
+        else{
+            uint8_t i = _PendingLeft ? SLOG_RECORD - _PendingLeft : 0;
+            eeprom_update_byte(slot(_Head) + i, _Queue[_QueueHead][i]);
+        }
+
+        if(!_PendingLeft){
+            _Head = (_Head + 1) % SLOG_SLOTS;
+            _Count++;
+            _Seq = (_Seq + 1) % 255;
+            _QueueHead = (_QueueHead + 1) & (SLOG_QUEUE - 1);
+            _QueueCnt--;
+        }
+    }
+}
+
+//records in the log
+uint8_t slog_count(){return _Count;}
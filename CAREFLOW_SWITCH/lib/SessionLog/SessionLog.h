@@ -0,0 +1,52 @@
+#ifndef SESSIONLOG_H
+#define SESSIONLOG_H
+
+#include <Arduino.h>
+
+#define SLOG_START 64                   //first EEPROM address of the log, the settings live below
+#define SLOG_END (E2END + 1)            //end of the log, the end of the EEPROM
+#define SLOG_RECORD 5                   //bytes per record
+#define SLOG_SLOTS ((SLOG_END - SLOG_START) / SLOG_RECORD)  //records the ring holds, must stay below 255
+#define SLOG_VERSION 2                  //export frame version
+#define SLOG_QUEUE 4                    //records that can wait to be written, must be a power of 2
+#define SLOG_MAX_PLANNED 0x3FFF         //longest planned time in seconds, the top 2 bits of the field hold the channel
+
+/* |
+* @brief session log - an append only ring of fixed size records in EEPROM, the oldest record is overwritten
+*        when it is full. A record is 5 bytes: sequence number, mode / end / pause count packed in one byte,
+*        channel and planned seconds in 16 bits (2 + 14) and the seconds short of the plan (actual = planned - short,
+*        short saturates at 255). Records of version 1 have no channel bits, they read as channel 0.
+*        The sequence numbers count on by one from record to record, so slog_init() finds the head where
+*        they break with one pass over the sequence bytes. A slot in use is written voided sequence byte first,
+*        then the payload, then the new sequence byte, so a reset in between never leaves the new payload under the
+*        old number - slog_init() drops such a torn slot, and an export never reads the slot being written.
+*        Nothing here waits: slog_append() queues the record, slog_task() writes one byte when the EEPROM is
+*        ready and sends the export as far as the serial transmit buffer has room.
+*
+*        Export frame: 'S' 'L' version record_size count, then count records oldest first, byte for byte
+*        as stored, then a checksum byte - all bytes of the frame add up to 0 (mod 256).
+*        scripts/sessionlog_decode.py turns it into CSV.
+*/
+
+enum slogEnd{
+    SLOG_COMPLETE,              //ran for its full time
+    SLOG_STOPPED,               //stopped before its time
+    SLOG_RESTARTED              //started over before its time
+};
+
+struct SlogRecord{
+    uint8_t channel;            //output channel, 0-3
+    uint8_t mode;               //mode number, 1-3
+    uint8_t end;                //one of slogEnd
+    uint8_t pauses;             //times the session was paused, saturates at 15
+    uint16_t plannedS;          //planned length in seconds, saturates at SLOG_MAX_PLANNED
+    uint16_t actualS;           //time it ran in seconds
+};
+
+void slog_init();                               //finds the head of the log
+bool slog_append(const SlogRecord *r);          //queues a record for writing, false while SLOG_QUEUE records still wait
+void slog_export();                             //starts sending the log over Serial
+void slog_task();                               //writes a queued byte or sends export bytes, never waits
+uint8_t slog_count();                           //records in the log
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef TASKS_H
+#define TASKS_H
+
+#include <Arduino.h>
+
+/* |
+* @brief cooperative tasks - a table of task functions run by one scheduler pass from loop().
+*        A task must return quickly; work that has to wait is written as a protothread (PT_ macros)
+*        which returns at every wait and resumes at the same line on its next start.
+*        Protothread locals are lost at every wait, keep anything needed after it in statics.
+*
+*        Every start is timed: costUs / maxCostUs hold the last and the worst run time and maxLateMs
+*        how long the task was started past its due time. A due task waits for at most one pass over
+*        the table, so tasks_latencyBoundUs() (the sum of the worst run times plus the 1ms resolution
+*        of millis) bounds the start delay of every task as long as the tasks keep to their measured cost.
+*/
+
+// PROTOTHREADS ---------------------------------------------------------------------------
+
+typedef uint16_t Pt;            //resume point of a protothread (source line), 0 = start
+
+#define PT_BEGIN(pt)            switch(pt){case 0:
+#define PT_YIELD(pt)            do{(pt) = __LINE__; return; case __LINE__:;}while(0)
+#define PT_WAIT_UNTIL(pt, cond) do{(pt) = __LINE__; case __LINE__: if(!(cond)){return;}}while(0)
+#define PT_END(pt)              } (pt) = 0
+
+// SCHEDULER ------------------------------------------------------------------------------
+
+struct Task{
+    void (*run)();              //task body, returns at every wait
+    uint16_t periodMs;          //minimum time between two starts, 0 = every pass
+    uint16_t lastMs;            //when the task was last started
+    uint16_t costUs;            //run time of the last start
+    uint16_t maxCostUs;         //worst run time seen
+    uint16_t maxLateMs;         //worst start delay past the due time seen
+};
+
+#define TASK(fn, periodMs)      {fn, periodMs, 0, 0, 0, 0}
+
+void tasks_run(Task *tasks, uint8_t count);                     //one pass over the table, starts every task that is due
+uint32_t tasks_latencyBoundUs(const Task *tasks, uint8_t count);    //worst start delay of a due task from the measured costs
+
+//makes the task due on the next pass, whatever its period
+static inline void tasks_due(Task *t){t->lastMs = (uint16_t)millis() - t->periodMs;}
+
+#endif
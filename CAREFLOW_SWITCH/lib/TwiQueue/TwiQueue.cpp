@@ -0,0 +1,211 @@
+#include "TwiQueue.h"
+#include <avr/interrupt.h>
+#include <util/twi.h>
+
+#define TWIQ_MASK (TWIQ_SIZE - 1)
+#define TWIQ_HEADER 4
+#define TWIQ_MAX_LEN (TWIQ_SIZE - TWIQ_HEADER - 1)  //largest payload that fits next to its header
+
+// each transaction is stored as [SLA+W][payload length][strobe][ctrl][payload ...], strobe 0 = plain bytes
+static uint8_t _Buf[TWIQ_SIZE];
+static volatile uint8_t _Head;          //end of the published transactions (written by the queue side only)
+static volatile uint8_t _Tail;          //next byte the interrupt will send (written by the interrupt only)
+static volatile bool _Busy;             //true from the start condition until the stop condition
+static uint8_t _Left;                   //payload bytes left in the transaction on the bus
+static uint8_t _Strobe;                 //strobe bits of the transaction on the bus, 0 for plain bytes
+static uint8_t _Ctrl;                   //control bits added to every nibble of the transaction on the bus
+static uint8_t _Phase;                  //expander byte (0-5) of the nibble pair being sent
+static uint8_t _Nibble;                 //payload byte being sent as nibbles
+static uint8_t _Wr;                     //write position of the transaction being built
+static uint8_t _LenPos;                 //position of the length byte of the transaction being built
+static uint8_t _Len;                    //payload length of the transaction being built
+
+#define TWCR_ACK   (_BV(TWINT) | _BV(TWEN) | _BV(TWIE))
+#define TWCR_START (_BV(TWINT) | _BV(TWEN) | _BV(TWIE) | _BV(TWSTA))
+#define TWCR_STOP  (_BV(TWINT) | _BV(TWEN) | _BV(TWSTO))
+
+//sets up the TWI hardware for the given SCL frequency
+void twiq_init(uint32_t frequency){
+
+    //internal pull ups on SDA/SCL the same way Wire does
+    PORTC |= _BV(PORTC4) | _BV(PORTC5);
+
+    //prescaler 1
+    TWSR = 0;
+    TWBR = ((F_CPU / frequency) - 16) / 2;
+    TWCR = _BV(TWEN);
+
+    _Head = 0; _Tail = 0; _Busy = false;
+}
+
+//number of free bytes in the queue (one byte is kept unused to tell full from empty)
+uint8_t twiq_free(){return (uint8_t)(_Tail - _Head - 1) & TWIQ_MASK;}
+
+//starts the bus if the interrupt is not already working through the queue
+static void kick(){
+    uint8_t sreg = SREG;
+    cli();
+    if(!_Busy && _Head != _Tail){
+
+        //a stop condition may still be going out from the last transaction
+        while(TWCR & _BV(TWSTO)){}
+        _Busy = true;
+        TWCR = TWCR_START;
+    }
+    SREG = sreg;
+}
+
+//true when the queue is empty and the bus is released
+bool twiq_idle(){return _Head == _Tail && !_Busy && !(TWCR & _BV(TWSTO));}
+
+//barrier - waits until every queued transaction is on the bus (restarts the bus if an error stopped it)
+void twiq_flush(){while(!twiq_idle()){kick();}}
+
+//waits for room in the queue - the interrupt keeps draining it meanwhile
+static void waitFree(uint8_t cnt){while(((uint8_t)(_Tail - _Wr - 1) & TWIQ_MASK) < cnt){kick();}}
+
+//starts building a write transaction in the queue, every byte put goes out as two strobed nibbles
+void twiq_beginNibbles(uint8_t addr, uint8_t ctrl, uint8_t strobe){
+    _Wr = _Head;
+    waitFree(TWIQ_HEADER);
+    _Buf[_Wr] = (addr << 1) | TW_WRITE; _Wr = (_Wr + 1) & TWIQ_MASK;
+    _LenPos = _Wr; _Wr = (_Wr + 1) & TWIQ_MASK;
+    _Buf[_Wr] = strobe; _Wr = (_Wr + 1) & TWIQ_MASK;
+    _Buf[_Wr] = ctrl; _Wr = (_Wr + 1) & TWIQ_MASK;
+    _Len = 0;
+}
+
+//starts building a write transaction in the queue
+void twiq_begin(uint8_t addr){twiq_beginNibbles(addr, 0, 0);}
+
+//appends a byte to the transaction being built - a full transaction is split into a new one with the same header
+void twiq_put(uint8_t data){
+    if(_Len == TWIQ_MAX_LEN){
+        uint8_t sla = _Buf[(_LenPos - 1) & TWIQ_MASK];
+        uint8_t strobe = _Buf[(_LenPos + 1) & TWIQ_MASK];
+        uint8_t ctrl = _Buf[(_LenPos + 2) & TWIQ_MASK];
+        twiq_end();
+        twiq_beginNibbles(sla >> 1, ctrl, strobe);
+    }
+    waitFree(1);
+    _Buf[_Wr] = data; _Wr = (_Wr + 1) & TWIQ_MASK;
+    _Len++;
+}
+
+//hands the transaction being built over to the interrupt
+void twiq_end(){
+    _Buf[_LenPos] = _Len;
+    _Head = _Wr;
+    kick();
+}
+
+//queues a complete write transaction, false if it can never fit
+bool twiq_write(uint8_t addr, const uint8_t *data, uint8_t len){
+    if(len > TWIQ_MAX_LEN){return false;}
+    twiq_begin(addr);
+    for(uint8_t i = 0; i < len; i++){twiq_put(data[i]);}
+    twiq_end();
+    return true;
+}
+
+//waits for the hardware to finish the current bus step and returns the status
+static uint8_t pollStep(uint8_t twcr){
+    TWCR = twcr;
+    while(!(TWCR & _BV(TWINT))){}
+    return TW_STATUS;
+}
+
+//flushes the queue then reads one byte (blocking), -1 if no answer.
+//The read is polled with the interrupt off - the queue is empty so nothing else uses the bus meanwhile
+int16_t twiq_readByte(uint8_t addr){
+
+    int16_t data = -1;
+
+    twiq_flush();
+
+    uint8_t status = pollStep(_BV(TWINT) | _BV(TWEN) | _BV(TWSTA));
+    if(status == TW_START){
+        TWDR = (addr << 1) | TW_READ;
+        if(pollStep(_BV(TWINT) | _BV(TWEN)) == TW_MR_SLA_ACK){
+
+            //single byte -> answer with NACK
+            if(pollStep(_BV(TWINT) | _BV(TWEN)) == TW_MR_DATA_NACK){data = TWDR;}
+        }
+    }
+    TWCR = TWCR_STOP;
+    while(TWCR & _BV(TWSTO)){}
+
+    return data;
+}
+
+//moves on to the next queued transaction with a repeated start, or releases the bus
+static inline void nextTransaction(){
+    if(_Head != _Tail){TWCR = TWCR_START;}
+    else{TWCR = TWCR_STOP; _Busy = false;}
+}
+
+ISR(TWI_vect){
+    switch(TW_STATUS){
+
+        //start sent -> address the slave of the transaction at the tail
+        case TW_START:
+        case TW_REP_START:
+            TWDR = _Buf[_Tail];
+            _Left = _Buf[(_Tail + 1) & TWIQ_MASK];
+            _Strobe = _Buf[(_Tail + 2) & TWIQ_MASK];
+            _Ctrl = _Buf[(_Tail + 3) & TWIQ_MASK];
+            _Phase = 0;
+            _Tail = (_Tail + TWIQ_HEADER) & TWIQ_MASK;
+            TWCR = TWCR_ACK;
+            break;
+
+        //slave took the last byte -> send the next one or finish the transaction
+        case TW_MT_SLA_ACK:
+        case TW_MT_DATA_ACK:
+
+            //plain bytes go out as they are
+            if(_Strobe == 0){
+                if(_Left > 0){
+                    TWDR = _Buf[_Tail];
+                    _Tail = (_Tail + 1) & TWIQ_MASK;
+                    _Left--;
+                    TWCR = TWCR_ACK;
+                }
+                else{nextTransaction();}
+            }
+
+            //nibble bytes go out as data, data + strobe, data for the high then the low nibble
+            else if(_Left > 0 || _Phase != 0){
+                uint8_t out;
+                switch(_Phase){
+                    case 0: _Nibble = _Buf[_Tail]; _Tail = (_Tail + 1) & TWIQ_MASK; _Left--;
+                            out = (_Nibble & 0xF0) | _Ctrl; break;
+                    case 1: out = (_Nibble & 0xF0) | _Ctrl | _Strobe; break;
+                    case 2: out = (_Nibble & 0xF0) | _Ctrl; break;
+                    case 4: out = (uint8_t)(_Nibble << 4) | _Ctrl | _Strobe; break;
+                    default: out = (uint8_t)(_Nibble << 4) | _Ctrl; break;
+                }
+                _Phase = (_Phase == 5) ? 0 : _Phase + 1;
+                TWDR = out;
+                TWCR = TWCR_ACK;
+            }
+            else{nextTransaction();}
+            break;
+
+        //slave missing or refused the data -> drop the rest of the transaction
+        case TW_MT_SLA_NACK:
+        case TW_MT_DATA_NACK:
+            _Tail = (_Tail + _Left) & TWIQ_MASK;
+            _Left = 0; _Phase = 0;
+            nextTransaction();
+            break;
+
+        //bus error or lost arbitration -> drop the transaction and release the bus
+        default:
+            _Tail = (_Tail + _Left) & TWIQ_MASK;
+            _Left = 0; _Phase = 0;
+            TWCR = TWCR_STOP;
+            _Busy = false;
+            break;
+    }
+}
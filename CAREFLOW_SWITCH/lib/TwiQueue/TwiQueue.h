@@ -0,0 +1,29 @@
+#ifndef TWIQUEUE_H
+#define TWIQUEUE_H
+
+#include <Arduino.h>
+
+#define TWIQ_SIZE 128           //transmit ring size in bytes, must be a power of 2 (max 256)
+
+/* |
+* @brief interrupt driven I2C master transmit queue - writes return as soon as the
+*        transaction is queued and the TWI interrupt sends it in the background.
+*        Owns the TWI hardware, so it can not be linked together with Wire.
+*
+*        Nibble transactions are meant for 4 bit parallel devices behind an I/O expander: every byte put
+*        is sent as 6 expander bytes - high nibble | ctrl, same | strobe, same, then the low nibble the same
+*        way. The expansion is done by the interrupt, so a queued character only takes one byte of the ring.
+*/
+
+void twiq_init(uint32_t frequency);                             //sets up the TWI hardware for the given SCL frequency
+bool twiq_write(uint8_t addr, const uint8_t *data, uint8_t len);    //queues a complete write transaction, false if it can never fit
+void twiq_begin(uint8_t addr);                                  //starts building a write transaction in the queue
+void twiq_beginNibbles(uint8_t addr, uint8_t ctrl, uint8_t strobe);    //same, but every byte put goes out as two strobed nibbles
+void twiq_put(uint8_t data);                                    //appends a byte to the transaction being built
+void twiq_end();                                                //hands the transaction being built over to the interrupt
+uint8_t twiq_free();                                            //number of free bytes in the queue
+bool twiq_idle();                                               //true when the queue is empty and the bus is released
+void twiq_flush();                                              //barrier - waits until every queued transaction is on the bus
+int16_t twiq_readByte(uint8_t addr);                            //flushes the queue then reads one byte (blocking), -1 if no answer
+
+#endif
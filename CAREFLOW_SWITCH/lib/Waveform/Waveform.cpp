@@ -0,0 +1,200 @@
+#include "Waveform.h"
+#include <avr/interrupt.h>
+#include <util/atomic.h>
+
+#define WAVE_FRAME_START 0xFF   //_Next while the start of the next software frame is due
+
+const WaveStep waveSteady[] PROGMEM = {{255, 100}, {0, 0}};
+const WaveStep wavePulse[] PROGMEM = {{255, 100}, {0, 100}, {0, 0}};
+const WaveStep waveTrain[] PROGMEM = {{255, 15}, {0, 10}, {255, 15}, {0, 10}, {255, 15}, {0, 80}, {0, 0}};
+const WaveStep waveRamp[] PROGMEM = {
+    {64, 10}, {96, 10}, {128, 10}, {160, 10}, {192, 10}, {224, 10}, {255, 30},
+    {224, 10}, {192, 10}, {160, 10}, {128, 10}, {96, 10}, {64, 10}, {0, 50}, {0, 0}
+};
+
+//switching plan of the software channels for one 1ms frame
+struct SoftFrame{
+    uint8_t cnt;                                //channels switched on at the start of the frame
+    uint8_t edges;                              //the first ones of them go off again within the frame
+    uint8_t ch[WAVE_CHANNELS];                  //channels by off count, the fully on ones last
+    uint8_t off[WAVE_CHANNELS];                 //Timer1 count each channel goes off at
+};
+
+static const WaveStep *_Pattern[WAVE_CHANNELS]; //pattern of each channel
+static volatile uint8_t *_Ocr[WAVE_CHANNELS];   //compare register of a hardware channel, nullptr for a software one
+static uint8_t _Com[WAVE_CHANNELS];             //TCCR2A bit connecting a hardware channel to its pin
+static volatile uint8_t *_Out[WAVE_CHANNELS];   //output register of each channel pin
+static uint8_t _Bit[WAVE_CHANNELS];             //bit of each channel pin
+static uint8_t _Soft;                           //bit per software channel
+static volatile uint8_t _Step[WAVE_CHANNELS];   //step of the pattern playing
+static volatile uint8_t _Left[WAVE_CHANNELS];   //ticks left of the step
+static volatile uint8_t _Level[WAVE_CHANNELS];  //level of the step
+static volatile uint8_t _Div = WAVE_TICK_DIV;   //overflows left of the tick
+static volatile uint8_t _On;                    //bit per playing channel
+
+static SoftFrame _Frame[2];                     //the frame playing and the next one
+static volatile uint8_t _Live;                  //frame playing
+static volatile bool _Swap;                     //the other frame is newer, it is taken at the next frame start
+static volatile uint8_t _Next = WAVE_FRAME_START;   //edge of the frame playing due next
+
+//connects a hardware channel to its pin while it plays a level above 0 - fast PWM still gives a 1/256 pulse
+//at OCR 0, so at level 0 the pin is left to its PORT bit (low), as analogWrite(pin, 0) does - interrupts must be off
+static void connect(uint8_t ch){
+    if((_On & _BV(ch)) && _Level[ch]){TCCR2A |= _Com[ch];} else{TCCR2A &= ~_Com[ch];}
+}
+
+//loads the step of the channel, true when the level of a software channel changed - interrupts must be off
+static bool load(uint8_t ch, uint8_t step){
+
+    const WaveStep *p = _Pattern[ch];
+    if(pgm_read_byte(&p[step].ticks) == 0){step = 0;}
+    _Step[ch] = step;
+    _Left[ch] = pgm_read_byte(&p[step].ticks);
+    uint8_t level = pgm_read_byte(&p[step].level);
+    bool changed = level != _Level[ch];
+    _Level[ch] = level;
+    if(_Ocr[ch]){*_Ocr[ch] = level; connect(ch); return false;}
+    return changed;
+}
+
+//plans the next software frame from the levels playing, the frame interrupt only runs while a software channel plays - interrupts must be off
+static void schedule(){
+
+    SoftFrame *f = &_Frame[_Live ^ 1];
+    uint8_t playing = _On & _Soft;
+    uint8_t edges = 0;
+
+    //channels going off within the frame, sorted by their count
+    for(uint8_t ch = 0; ch < WAVE_CHANNELS; ch++){
+        uint8_t level = _Level[ch];
+        if(!(playing & _BV(ch)) || level == 0 || level == 255){continue;}
+        uint8_t off = ((uint16_t)level * WAVE_SOFT_STEPS) >> 8;
+        if(off == 0){off = 1;}
+        uint8_t i = edges++;
+        for(; i && f->off[i - 1] > off; i--){f->off[i] = f->off[i - 1]; f->ch[i] = f->ch[i - 1];}
+        f->off[i] = off;
+        f->ch[i] = ch;
+    }
+
+    //fully on channels have no edge
+    uint8_t cnt = edges;
+    for(uint8_t ch = 0; ch < WAVE_CHANNELS; ch++){if((playing & _BV(ch)) && _Level[ch] == 255){f->ch[cnt++] = ch;}}
+
+    f->cnt = cnt;
+    f->edges = edges;
+    _Swap = true;
+
+    if(!playing){TIMSK1 &= ~_BV(OCIE1B);}
+    else if(!(TIMSK1 & _BV(OCIE1B))){
+        _Next = WAVE_FRAME_START;
+        OCR1B = 0;
+        TIFR1 = _BV(OCF1B);
+        TIMSK1 |= _BV(OCIE1B);
+    }
+}
+
+//one overflow per PWM period, the envelopes move on every WAVE_TICK_DIV of them
+ISR(TIMER2_OVF_vect){
+
+    if(--_Div){return;}
+    _Div = WAVE_TICK_DIV;
+
+    bool soft = false;
+    uint8_t on = _On;
+    for(uint8_t ch = 0; on; ch++, on >>= 1){
+        if((on & 1) && --_Left[ch] == 0){soft |= load(ch, _Step[ch] + 1);}
+    }
+    if(soft){schedule();}
+}
+
+//software frame: every channel on at count 0, then one match per distinct off count
+ISR(TIMER1_COMPB_vect){
+
+    if(_Next == WAVE_FRAME_START){
+
+        //the fully on channels of the old frame never went off, the new frame switches on what it keeps
+        if(_Swap){
+            const SoftFrame *old = &_Frame[_Live];
+            for(uint8_t i = old->edges; i < old->cnt; i++){uint8_t ch = old->ch[i]; *_Out[ch] &= ~_Bit[ch];}
+            _Live ^= 1;
+            _Swap = false;
+        }
+        const SoftFrame *f = &_Frame[_Live];
+        for(uint8_t i = 0; i < f->cnt; i++){uint8_t ch = f->ch[i]; *_Out[ch] |= _Bit[ch];}
+        _Next = 0;
+    }
+
+    //every edge due by the next count, so close edges never wait for a match that has passed already
+    const SoftFrame *f = &_Frame[_Live];
+    uint8_t next = _Next;
+    uint8_t now = TCNT1 + 1;
+    while(next < f->edges && f->off[next] <= now){uint8_t ch = f->ch[next++]; *_Out[ch] &= ~_Bit[ch];}
+
+    if(next < f->edges){_Next = next; OCR1B = f->off[next];}
+    else{_Next = WAVE_FRAME_START; OCR1B = 0;}
+}
+
+//pin low and the channel set up on it, nothing plays yet
+void wave_init(uint8_t ch, uint8_t pin){
+
+    if(ch >= WAVE_CHANNELS){return;}
+
+    digitalWrite(pin, LOW);
+    pinMode(pin, OUTPUT);
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+        _Out[ch] = portOutputRegister(digitalPinToPort(pin));
+        _Bit[ch] = digitalPinToBitMask(pin);
+
+        //the Timer2 compare outputs are hardware channels, any other pin is switched by the software frame
+        switch(digitalPinToTimer(pin)){
+            case TIMER2A: _Ocr[ch] = &OCR2A; _Com[ch] = _BV(COM2A1); _Soft &= ~_BV(ch); break;
+            case TIMER2B: _Ocr[ch] = &OCR2B; _Com[ch] = _BV(COM2B1); _Soft &= ~_BV(ch); break;
+            default: _Ocr[ch] = nullptr; _Com[ch] = 0; _Soft |= _BV(ch);
+        }
+        _Pattern[ch] = waveSteady;
+        load(ch, 0);
+
+        //fast PWM, clk/64 -> 16MHz / 64 / 256 = 976Hz, the channels already playing stay connected
+        TCCR2A = (TCCR2A & (_BV(COM2A1) | _BV(COM2B1))) | _BV(WGM21) | _BV(WGM20);
+        TCCR2B = _BV(CS22);
+    }
+}
+
+//true when the channel is a hardware PWM channel
+bool wave_hardware(uint8_t ch){return ch < WAVE_CHANNELS && _Ocr[ch];}
+
+//sets the PROGMEM pattern of the channel, played from its start
+void wave_select(uint8_t ch, const WaveStep *pattern){
+
+    if(ch >= WAVE_CHANNELS){return;}
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+        _Pattern[ch] = pattern;
+        if(load(ch, 0) && (_On & _BV(ch))){schedule();}
+    }
+}
+
+//plays the channel on from where it stopped
+void wave_start(uint8_t ch){
+
+    if(ch >= WAVE_CHANNELS){return;}
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+        if(!_On){TIFR2 = _BV(TOV2); TIMSK2 |= _BV(TOIE2);}
+        _On |= _BV(ch);
+        if(_Soft & _BV(ch)){schedule();} else{connect(ch);}
+    }
+}
+
+//the pin of the channel goes low (PORT bit is low), the position is kept
+void wave_stop(uint8_t ch){
+
+    if(ch >= WAVE_CHANNELS){return;}
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+        _On &= ~_BV(ch);
+        if(!_On){TIMSK2 &= ~_BV(TOIE2);}
+        if(_Soft & _BV(ch)){*_Out[ch] &= ~_Bit[ch]; schedule();} else{connect(ch);}
+    }
+}
+
+//level being played, 0 when stopped
+uint8_t wave_level(uint8_t ch){return ch < WAVE_CHANNELS && (_On & _BV(ch)) ? _Level[ch] : 0;}
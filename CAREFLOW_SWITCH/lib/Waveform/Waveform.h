@@ -0,0 +1,39 @@
+#ifndef WAVEFORM_H
+#define WAVEFORM_H
+
+#include <Arduino.h>
+
+#define WAVE_CHANNELS 4         //most output channels
+#define WAVE_TICK_DIV 10        //Timer2 overflows (1.024ms each) per envelope tick, so a tick is about 10ms
+#define WAVE_SOFT_STEPS 250     //Timer1 counts per 1ms frame of the session timer, the resolution of a software channel
+
+/* |
+* @brief PWM waveform player - plays an intensity envelope from a PROGMEM step table on every channel in the
+*        background, each channel with its own pattern, position and start/stop. Timer2 runs fast PWM at about
+*        976Hz: a channel on OC2A (pin 11) or OC2B (pin 3) is a hardware PWM channel, any other pin is a software
+*        channel. The Timer2 overflow interrupt counts the ticks of all channels and loads the next level when
+*        a step ends. A hardware channel at level 0 is disconnected from its pin, so it is fully off. The software channels are multiplexed on Timer1 compare B inside the 1ms frame of the
+*        session timer (sess_init() must have started it): all of them go on at the start of the frame and each
+*        goes off at its own count, one interrupt per distinct level and frame, so about 1kHz at 250 steps.
+*        Tables repeat until stopped. Owns Timer2 (tone() is not available) and compare B of Timer1.
+*/
+
+//one envelope step - a PWM level held for a number of ticks
+struct WaveStep{
+    uint8_t level;              //duty cycle, 0 = off, 255 = fully on
+    uint8_t ticks;              //length in ticks of WAVE_TICK_DIV overflows, 0 ends the table (it starts over)
+};
+
+extern const WaveStep waveSteady[] PROGMEM;     //fully on
+extern const WaveStep wavePulse[] PROGMEM;      //on/off duty cycle - 1s on, 1s off
+extern const WaveStep waveTrain[] PROGMEM;      //pulse train - three short bursts, then a rest
+extern const WaveStep waveRamp[] PROGMEM;       //ramps up and down again over about 2s
+
+void wave_init(uint8_t ch, uint8_t pin);        //pin low and the channel set up on it, nothing plays yet
+bool wave_hardware(uint8_t ch);                 //true when the channel is a hardware PWM channel
+void wave_select(uint8_t ch, const WaveStep *pattern);  //sets the PROGMEM pattern of the channel, played from its start
+void wave_start(uint8_t ch);                    //plays the channel on from where it stopped
+void wave_stop(uint8_t ch);                     //the pin of the channel goes low, the position is kept
+uint8_t wave_level(uint8_t ch);                 //level being played, 0 when stopped
+
+#endif
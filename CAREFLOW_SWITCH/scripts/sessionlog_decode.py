@@ -0,0 +1,73 @@
+# Session log export decoder: finds the export frame in a capture of the serial output and prints it as CSV.
+# capture the frame (menu SETTINGS > EXPORT LOG) and decode it with either of:
+#   python scripts/sessionlog_decode.py capture.bin > sessions.csv
+#   python scripts/sessionlog_decode.py --port /dev/ttyUSB0 > sessions.csv      (needs pyserial)
+import argparse
+import sys
+
+SYNC = b"SL"
+VERSIONS = (1, 2)  # version 1 records have no channel bits
+ENDS = ("complete", "stopped", "restarted", "unknown")
+MODES = ("off", "continuous", "intermittent", "demo")
+
+
+def find_frame(data):
+    """returns the records of the first complete frame with a good checksum, None when there is none"""
+    start = data.find(SYNC)
+    while start >= 0:
+        head = data[start:start + 5]
+        if len(head) == 5 and head[2] in VERSIONS:
+            size, count = head[3], head[4]
+            end = start + 5 + size * count + 1
+            frame = data[start:end]
+            if len(frame) == end - start and sum(frame) % 256 == 0:
+                return [frame[5 + i * size:5 + (i + 1) * size] for i in range(count)]
+        start = data.find(SYNC, start + 1)
+    return None
+
+
+def read_port(port):
+    import serial
+
+    data = b""
+    with serial.Serial(port, 115200, timeout=5) as ser:
+        while True:
+            chunk = ser.read(256)
+            if not chunk:
+                return data
+            data += chunk
+            if find_frame(data) is not None:
+                return data
+
+
+def main():
+    parser = argparse.ArgumentParser(description="decode the CAREFLOW session log export into CSV")
+    parser.add_argument("capture", nargs="?", help="binary capture of the serial output, stdin when omitted")
+    parser.add_argument("--port", help="read the export straight from this serial port")
+    args = parser.parse_args()
+
+    if args.port:
+        data = read_port(args.port)
+    elif args.capture:
+        with open(args.capture, "rb") as f:
+            data = f.read()
+    else:
+        data = sys.stdin.buffer.read()
+
+    records = find_frame(data)
+    if records is None:
+        sys.stderr.write("sessionlog_decode: no complete export frame found\n")
+        return 1
+
+    print("seq,channel,mode,end,pauses,planned_s,actual_s")
+    for r in records:
+        seq, flags = r[0], r[1]
+        channel = (r[3] >> 6) + 1
+        planned = r[2] | ((r[3] & 0x3F) << 8)
+        actual = planned - r[4]
+        print("%d,%d,%s,%s,%d,%d,%d" % (seq, channel, MODES[flags & 3], ENDS[(flags >> 2) & 3], flags >> 4, planned, actual))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -1,16 +1,33 @@
 #include <Arduino.h>
-#include <Wire.h>
-#include <LiquidCrystal_I2C.h>
 #include <EEPROM.h>
 #include <Pressbutton.h>
+#include <LcdI2C.h>
+#include <LcdShadow.h>
+#include <LcdGlyphs.h>
+#include <NumFmt.h>
+#include <Menu.h>
+#include <Tasks.h>
+#include <Power.h>
+#include <Gestures.h>
+#include <Session.h>
+#include <Waveform.h>
+#include <SessionLog.h>
 
 #define DISP_ITEM_ROWS 2        //number of rows usable in the display(depends on display size)
 #define DISP_CHAR_WIDTH 16      //general info about the hiw many characters in single rows
 #define PACING_MS 25            //minimum wait milisecond between executing code in menu loop
 #define FLASH_RST_CNT 30        //number of loops between switching flash state
 #define SETTING_CHKVAL 3647     //value used to manage versioning control
+#define MENU_VALUE_COL 13       //column where the bound values of the menu items are printed
+#ifdef PWR_AWAKE
+#define SLEEP_AFTER_MS 0UL      //never sleeps, see Power.h
+#else
+#define SLEEP_AFTER_MS 60000UL  //time without a button press before the display goes off and the MCU powers down, 0 = never
+#endif
 #define VIBRATION_MOTOR_PIN 11      // Vibration Motor (control pin for motor driver)
 #define LED_GREEN 10
+#define MOTOR_CHANNELS 4        //vibration motors, each runs its own session
+#define NOTE_MS 1000            //time a session notification stays over the page
 
 // ===========================================================
 // ||                   DECLARATIONS                        ||
@@ -25,29 +42,34 @@ const int BTN_PLUS = 6;
 const int BTN_MINUS = 7;
 
 //BUTTONS --------------------------------------------------------------------------
-PressButton btnOk(BTN_OK);
-PressButton btnBack(BTN_BACK);
-PressButton btnUp(BTN_UP);
-PressButton btnDown(BTN_DOWN);
-PressButton btnPlus(BTN_PLUS);
-PressButton btnMinus(BTN_MINUS);
+PressButton<BTN_OK> btnOk;
+PressButton<BTN_BACK> btnBack;
+PressButton<BTN_UP> btnUp;
+PressButton<BTN_DOWN> btnDown;
+PressButton<BTN_PLUS> btnPlus;
+PressButton<BTN_MINUS> btnMinus;
+const uint8_t wakePins[] = {BTN_OK, BTN_BACK, BTN_UP, BTN_DOWN, BTN_PLUS, BTN_MINUS};     //any button wakes the device from power down
+uint8_t gestOk;                                                 //gestures of the OK button - session control on the session pages
+uint8_t gestBack;                                               //gestures of the BACK button
+uint8_t chordStop;                                              //OK + BACK chord - stops the session from any page
+bool chordHeld;                                                 //true from the chord until both buttons are released
+void gestureTask();                                             //recognizes the button gestures, stops the session on the chord
 
 // Variables for button state, mode selection, and magnetic switch status
-bool systemOn = false; // Indicates whether the system is currently active
-unsigned long lastButtonPressTime = 0; // Stores the time of the last button press
-int buttonPressCount = 0; // Counts the number of button presses
-int currentMode = 0; // 0: Off, 1: Mode 1, 2: Mode 2
-unsigned long modeEndTime = 0; // Stores the end time of the current mode
+uint8_t channelMode[MOTOR_CHANNELS]; // mode of the session of each channel - 0: Off, 1: Mode 1, 2: Mode 2, 3: Demo
+uint8_t selChannel = 1;         // channel the session pages start, numbered from 1 as shown
 bool sensorActivated = false; // Indicates whether the magnetic sensor is activated
 unsigned long sensorActivationTime = 0; // Stores the time of the last sensor activation
-bool sterilizationPaused = false; // Indicates whether the sterilization process is paused
-unsigned long remainingTime = 0; // Stores the remaining time when sterilization is paused
 
 // Constants for mode durations and magnetic switch debounce
-const unsigned long MODE1_DURATION = 60000; // 60 seconds / 1 min
-const unsigned long MODE2_DURATION = 30000; // 20 seconds
-const unsigned long DEMO_DURATION = 5000; // 5 seconds
-const unsigned long DOUBLE_PRESS_INTERVAL = 500; // Maximum interval between button presses for double press (milliseconds)
+const uint16_t MODE1_DURATION = 60; // 60 seconds / 1 min
+const uint16_t MODE2_DURATION = 30; // 30 seconds
+const uint16_t DEMO_DURATION = 5; // 5 seconds
+const uint16_t modeDurations[] PROGMEM = {0, MODE1_DURATION, MODE2_DURATION, DEMO_DURATION};   // session length in seconds by mode number (0: Off)
+const WaveStep *const modePatterns[] PROGMEM = {nullptr, waveSteady, wavePulse, waveRamp};       // motor envelope by mode number
+const uint8_t sessionPins[] = {LED_GREEN};                                                      // on while any session runs, switched by the session timer
+const uint8_t motorPins[MOTOR_CHANNELS] = {VIBRATION_MOTOR_PIN, 3, 5, 9};                      // motor of each channel - 11 and 3 are hardware PWM, 5 and 9 software PWM
+static_assert(MOTOR_CHANNELS <= SESS_CHANNELS && MOTOR_CHANNELS <= WAVE_CHANNELS, "more motors than session channels");
 const unsigned long SENSOR_DEBOUNCE_DELAY = 100; // Debounce delay for the magnetic sensor (milliseconds)
 
 // MENU STRUCTURE ------------------------------------------------------------------- 
@@ -56,31 +78,26 @@ enum pageType{
         MENU_ROOT,
         MENU_SUB1,
         MENU_SUB1_A,
-        //MENU_SUB1_B,
         MENU_SUB2,
         MENU_SUB2_A,
-        //MENU_SUB2_B,
         MENU_SUB3,
         MENU_SUB3_A,
         MENU_SETTINGS,
+        MENU_STATUS,
+        MENU_PAGE_CNT
 };
 
 enum pageType currPage = MENU_ROOT;
-void page_MenuRoot();
-void page_MenuSub1();
-void page_MenuSub1_A();
-//void page_MenuSub1_B();
-void page_MenuSub2();
-void page_MenuSub2_A();
-//void page_MenuSub2_B();
-void page_MenuSub3();
-void page_MenuSub3_A();
-void page_MenuSettings();
+MenuPage menuPage;                                              //RAM copy of the descriptor of the open page
+Pt menuPt;                                                      //menu protothread resume point
+void menuTask();                                                //menu protothread - opens the current page and steps it every PACING_MS
+void menuEnter(uint8_t id);                                     //opens the given page
+bool menuStep();                                                //one loop iteration of the open page, false once another page was selected
+void displayTask();                                             //sends whatever changed on the display
 
 
 // MENU INTERNALS ----------------------------------------------------------------------
 
-uint32_t loopStartMs;                                           //tracks when entered top of the lop
 bool updateAllitems;                                            //flag for updating items list
 bool updateItemvalue;                                        //position to update a specific items value
 uint8_t itemCnt;                                                //number of items in the current menu  
@@ -90,13 +107,15 @@ uint8_t root_pntrPos = 1;
 uint8_t root_dispOffSet = 0;
 uint8_t flashCntr;                                              //flash counter
 bool flashIsOn;                                                 //flash state
-void initMenuPages(String title, uint8_t itemCount );           //sets all the common menu values and prints the menu title
+void initMenuPages(const char *title, uint8_t titleLen, uint8_t itemCount); //sets all the common menu values and prints the PROGMEM menu title
 void captureButtonDownState();                                  //captures the pressed down state for all buttons (set only)
+uint32_t lastActivityMs;                                        //last time a button press was captured
+bool wakePress;                                                 //true from the wake up until every button is released
+void powerTask();                                               //powers down after SLEEP_AFTER_MS without a button press
 void adjustBoolean(bool *v);                                    // adjusts a Boolean value depending on the button state  
-void adjustUint8_t(uint8_t *v, uint8_t min, uint8_t max);       //adjusts a Boolean value depending on the button state
+void adjustUint8_t(uint8_t *v, uint8_t min, uint8_t max, const RepeatProfile *profile);        //adjusts a uint8_t value depending on the button state
 void doPointerNavigation();                                     //does the up/down point navigation
 bool isFlashChanged();                                          //Returns true whenever the flash state changes (flash interval = PACING_)
-void pacingWait();                                              //placed at the bottom of the loop to keep constant pacing of the intervals
 bool menuItemPrintable(uint8_t xPos, uint8_t yPos);             //will return a positive state if the item can be display - it will also posing  
 
 // PRINT TOOLS --------------------------------------------------------------------------------------
@@ -105,13 +124,37 @@ void printPointer();                                            //depending on f
 void printOffsetArrows();                                       //print the arrows to indicate if the menu extends beyond current view
 void printOnOff(boolean val);                                   //print either ON or OFF depending on the boolean state
 void printUint32_tAtWidth(uint32_t value, uint8_t width, char c, boolean isRight); 
+void printSeconds(uint32_t ms);                                 //prints the whole seconds of a millisecond count
+void printSecondsAtWidth(uint32_t ms, uint8_t width);           //same, right aligned in a field of width
+void printChars(uint8_t cnt, char c);                           //prints a character cnt times
+void printItemLabel(const MenuItem *item);                      //prints the label of a menu item, padded up to its value or the arrows
+void printItemValue(const MenuItem *item);                      //prints the bound value of a menu item
 
 //FUNCTION FOR UVC LED ---------------------------------------------------------------------------------
 void activateMode();
-void deactivateSystem();
+void motorOutput(uint8_t ch, bool on);                          //plays or stops the motor waveform of the channel with its session outputs
+void deactivateSystem(uint8_t ch, uint8_t end);                 //ends the session of the channel and logs it, end is one of slogEnd
 void displaySystemReady();
 void displayPhysiotherapyComplete();
-void check_system();
+void showCountdown();                                           //prints the remaining time on a session page
+void leaveSessionPage();                                        //session page on leave
+void therapyTask();                                             //session protothread - ends the sessions in the background
+Pt therapyPt;                                                   //session protothread resume point
+uint8_t doneChannel;                                            //channel whose session end therapyTask handles
+uint8_t completeChannel();                                      //first channel whose session time ran out, MOTOR_CHANNELS when none
+bool sessionPageOpen;                                           //true while a session page shows the countdown
+void toggleMode(int mode);                                      //starts the mode on the selected channel, or pauses/resumes the channel
+int sessionMode;                                                //mode of the open session page
+uint8_t sessionChannel;                                         //channel of the open session page
+uint8_t channelPauses[MOTOR_CHANNELS];                          //times the session of each channel was paused, for the session log
+void sessionLoop();                                             //session page on loop - countdown and OK gestures
+void stopSession(uint8_t ch);                                   //ends the running or paused session of the channel before its time
+void stopAllSessions();                                         //ends the session of every channel
+void statusLoop();                                              //status page on loop - the state of every channel
+void printChannelStatus(uint8_t ch);                            //prints the state and the seconds left of a channel in 4 cells
+void toggleMode1();
+void toggleMode2();
+void toggleDemo();
 
 // SETTINGS -------------------------------------------------------------------------------------------
 
@@ -125,52 +168,75 @@ struct MySettings{
         uint16_t settingCheckValue = SETTING_CHKVAL; //settings check value to confirm are valud !! MUST BE AT END !!
 };
 MySettings settings;                                            //primary settings object
+static_assert(sizeof(MySettings) <= SLOG_START, "the settings run into the session log");
 void sets_setDefaults();                                        //resets the settings object back to its default values 
 void sets_Load();                                                //loads the settings from the EEPROM into the settings object.
 void sets_Save();                                                 //save the values in the settings object into the EEPROM
 
 // DISPLAY
-LiquidCrystal_I2C lcd(0x27, 16, 2);     // set the LCD address to ex27 for a 16 chars and 2 line display
-byte chrUp[] = {0b00000,                // Arrow up custom character data
-                0b00100,
-                0b00100,
-                0b01110,
-                0b01110,
-                0b11111,
-                0b11111,
-                0b00000 };
-byte chrDn[] = {0b00000,                // Arrow down custom character data
-                0b11111,
-                0b11111,
-                0b01110,
-                0b01110,
-                0b00100,
-                0b00000 };
-byte chrF1[] = {0b10000,                // Menu title left side custom character data
-                0b01000,
-                0b10100,
-                0b01010,
-                0b10100,
-                0b01000,
-                0b10000,
-                0b00000 };
-byte chrF2[] = {                // Menu title right side custom character data
-                0b01000,
-                0b01100,
-                0b01110,
-                0b01111,
-                0b01111,
-                0b01110,
-                0b01100,
-                0b01000 };
-byte chrAr[] = {0b00000,                // Selected item pointer custom character data
-                0b01100,
-                0b11110,
-                0b10010,
-                0b11110,
-                0b01100,
-                0b00000,
-                0b00000 };
+LcdI2C lcdHw(0x27, 16, 2);              // set the LCD address to ex27 for a 16 chars and 2 line display
+LcdShadow lcd(lcdHw);                   // RAM shadow of the display, only changed cells are sent by displayTask()
+enum glyphType{
+        GLYPH_UP,                       // Arrow up
+        GLYPH_DN,                       // Arrow down
+        GLYPH_F1,                       // Menu title left side
+        GLYPH_F2,                       // Menu title right side
+        GLYPH_AR,                       // Selected item pointer
+};
+const uint8_t glyphTable[][8] PROGMEM = {
+        {0b00000,                       // Arrow up
+         0b00100,
+         0b00100,
+         0b01110,
+         0b01110,
+         0b11111,
+         0b11111,
+         0b00000},
+        {0b00000,                       // Arrow down
+         0b11111,
+         0b11111,
+         0b01110,
+         0b01110,
+         0b00100,
+         0b00100,
+         0b00000},
+        {0b10000,                       // Menu title left side
+         0b01000,
+         0b10100,
+         0b01010,
+         0b10100,
+         0b01000,
+         0b10000,
+         0b00000},
+        {0b01000,                       // Menu title right side
+         0b01100,
+         0b01110,
+         0b01111,
+         0b01111,
+         0b01110,
+         0b01100,
+         0b01000},
+        {0b00000,                       // Selected item pointer
+         0b01100,
+         0b11110,
+         0b10010,
+         0b11110,
+         0b01100,
+         0b00000,
+         0b00000}
+};
+const uint8_t menuGlyphs[] = {GLYPH_UP, GLYPH_DN, GLYPH_F1, GLYPH_F2, GLYPH_AR};      //glyphs every menu page uses
+LcdGlyphs glyphs(lcd, glyphTable);      // CGRAM slots, glyphs are uploaded when a page needs them
+
+// TASKS
+Task tasks[] = {
+        TASK(therapyTask, 10),          // session end, whatever page is open
+        TASK(gestureTask, GEST_TICK_MS),// button gestures
+        TASK(slog_task, 5),             // session log writes and export, a byte at a time
+        TASK(menuTask, PACING_MS),      // menu pages, also the pace of the pointer flash
+        TASK(displayTask, PACING_MS),   // display flushing
+        TASK(powerTask, 100),           // power down when nobody uses the device
+};
 
 // ===========================================================
 // ||                   SETUP                               ||
@@ -178,588 +244,411 @@ byte chrAr[] = {0b00000,                // Selected item pointer custom characte
 void setup() {
 
     lcd.init();
-    lcd.createChar(1, chrUp);
-    lcd.createChar(1, chrDn);
-    lcd.createChar(1, chrF1);
-    lcd.createChar(1, chrF2);
-    lcd.createChar(1, chrAr);
 
     lcd.backlight();
 
     lcd.clear();
     sets_Load();
+    slog_init();
+    Serial.begin(115200);               // session log export
         
-    // Pin Mode Configuration
-    pinMode(VIBRATION_MOTOR_PIN, OUTPUT);
-    pinMode(LED_GREEN, OUTPUT);
-    pinMode(BTN_OK, INPUT_PULLUP); // Using internal pull-up resistor for the button
-
-    // Initialize all outputs to LOW
-    digitalWrite(VIBRATION_MOTOR_PIN, LOW);
-    digitalWrite(LED_GREEN, LOW);
+    // Pin Mode Configuration, the session outputs and the motors start LOW
+    sess_init(sessionPins, sizeof sessionPins);
+    for (uint8_t ch = 0; ch < MOTOR_CHANNELS; ch++) {wave_init(ch, motorPins[ch]);}
+    sess_onOutputs(motorOutput);
+
+    // Gestures: single/double/long press of OK on the session pages, OK + BACK anywhere
+    gestOk = gest_add(BTN_OK);
+    gestBack = gest_add(BTN_BACK);
+    chordStop = gest_chord(gestOk, gestBack);
 }
 // ===========================================================
 // ||                  MAIN LOOP                            ||
 //============================================================
 void loop() {
 
-                switch(currPage){
-                case MENU_ROOT : page_MenuRoot();break;
-                case MENU_SUB1 : page_MenuSub1();break;
-                case MENU_SUB1_A : page_MenuSub1_A();break;
-                //case MENU_SUB1_B : page_MenuSub1_B();break;
-                case MENU_SUB2 : page_MenuSub2();break;
-                case MENU_SUB2_A : page_MenuSub2_A();break;
-                //case MENU_SUB2_B : page_MenuSub2_B();break;
-                case MENU_SUB3 : page_MenuSub3();break;
-                case MENU_SUB3_A : page_MenuSub3_A();break;
-                case MENU_SETTINGS : page_MenuSettings();break;
-                }
-                
-  }
-
-// ===========================================================
-// ||                  MENU ROOT                            ||
-//============================================================
-void page_MenuRoot(){
-
-        //initializes menu pages
-        initMenuPages(F("MAIN MENU"), 5);
-
-        // for the ROOT MENU we will recall last know position and off set of the display
-        pntrPos = root_pntrPos; dispOffset = root_dispOffSet; 
-
-        //inner loop
-        while (true){
-
-                //print the sipalay item when requested
-                if(updateAllitems){
+        //a new button event steps the menu (tasks[3]) at once instead of at its next pacing step
+        static uint8_t seenEvents;
+        if(bank_events != seenEvents){seenEvents = bank_events; tasks_due(&tasks[3]);}
 
-                        //print the visible item
-                        if(menuItemPrintable(1,1)){lcd.print(F("MODE 1     "));}
-                        if(menuItemPrintable(1,2)){lcd.print(F("MODE 2     "));}
-                        if(menuItemPrintable(1,3)){lcd.print(F("DEMO MODE  "));}
-                        if(menuItemPrintable(1,4)){lcd.print(F("SETTINGS   "));}
-
-                }
-        
-                if(isFlashChanged()){printPointer();}
-
-                //always clear update flags by this point
-                updateAllitems = false;
-
-                //capture the button down state
-                captureButtonDownState();
-
-                //check for the ok button
-                if(btnOk.PressReleased()){
-
-                        //for the ROOT MENU we will save last know position and offset of the display
-                        root_pntrPos = pntrPos; root_dispOffSet = dispOffset; 
-                        switch (pntrPos){
-                                case 1: currPage = MENU_SUB1; return;
-                                case 2: currPage = MENU_SUB2; return;
-                                case 3: currPage = MENU_SUB3; return;
-                                case 4: currPage = MENU_SETTINGS; return;
-                        }
-                }
-                
-                //otherwise check for pointer up or down button
-                doPointerNavigation();
+        tasks_run(tasks, sizeof tasks / sizeof tasks[0]);
 
-                //keep a specific pace
-                pacingWait();
-        }  
+        //nothing to do until the next interrupt, the millis tick at the latest
+        pwr_idle();
 }
+
 // ===========================================================
-// ||                  MODE 1                               ||
+// ||                  MENU PAGES                           ||
 //============================================================
-void page_MenuSub1(){
-
-        //initializes menu pages
-        initMenuPages(F("CONTINUOUS "), 3 );
-        
-        //inner loop
-        while (true){
-
-                //print the sipalay item when requested
-                if(updateAllitems){
-
-                        //print the visible item
-                        if(menuItemPrintable(1,1)){lcd.print(F("START "));}
-                        if(menuItemPrintable(1,2)){lcd.print(F("BACK  "));}
-
-                }
-        
-                if(isFlashChanged()){printPointer();}
-
-                //always clear update flags by this point
-                updateAllitems = false;
 
-                //capture the button down state
-                captureButtonDownState();
-
-                //check for the ok button
-                if(btnOk.PressReleased()){
-
-                        switch (pntrPos){
-                                case 1: currPage = MENU_SUB1_A; return;
-                                case 2: currPage = MENU_ROOT; return;
-                        }
-                }
-                else if(btnBack.PressReleased()){
+const char txtMainMenu[] PROGMEM = "MAIN MENU";
+const char txtContinuous[] PROGMEM = "CONTINUOUS";
+const char txtIntermittent[] PROGMEM = "INTERMITTENT";
+const char txtDemoMode[] PROGMEM = "DEMO MODE";
+const char txtSettings[] PROGMEM = "SETTINGS";
+const char txtChannel[] PROGMEM = "CHANNEL";
+const char txtStatus[] PROGMEM = "STATUS";
+const char txtChannels[] PROGMEM = "CHANNELS";
+
+const char txtItemMode1[] PROGMEM = "MODE 1";
+const char txtItemMode2[] PROGMEM = "MODE 2";
+const char txtItemStart[] PROGMEM = "START";
+const char txtItemBack[] PROGMEM = "BACK";
+const char txtSetting1[] PROGMEM = "Setting 1 = ";
+const char txtSetting2[] PROGMEM = "Setting 2 = ";
+const char txtSetting3[] PROGMEM = "Setting 3 = ";
+const char txtSetting4[] PROGMEM = "Setting 4 = ";
+const char txtSetting5[] PROGMEM = "Setting 5 = ";
+const char txtSetting6[] PROGMEM = "Setting 6 = ";
+const char txtExportLog[] PROGMEM = "EXPORT LOG";
+
+constexpr MenuItem itemsRoot[] PROGMEM = {
+        MENU_LINK(txtItemMode1, MENU_SUB1),
+        MENU_LINK(txtItemMode2, MENU_SUB2),
+        MENU_LINK(txtDemoMode, MENU_SUB3),
+        MENU_UINT8(txtChannel, selChannel, 1, MOTOR_CHANNELS),
+        MENU_LINK(txtStatus, MENU_STATUS),
+        MENU_LINK(txtSettings, MENU_SETTINGS)
+};
+constexpr MenuItem itemsSub1[] PROGMEM = {
+        MENU_LINK(txtItemStart, MENU_SUB1_A),
+        MENU_BACK(txtItemBack)
+};
+constexpr MenuItem itemsSub2[] PROGMEM = {
+        MENU_LINK(txtItemStart, MENU_SUB2_A),
+        MENU_BACK(txtItemBack)
+};
+constexpr MenuItem itemsSub3[] PROGMEM = {
+        MENU_LINK(txtItemStart, MENU_SUB3_A),
+        MENU_BACK(txtItemBack)
+};
+constexpr MenuItem itemsSettings[] PROGMEM = {
+        MENU_BOOL(txtSetting1, settings.Test1_OnOff),
+        MENU_UINT8_FAST(txtSetting2, settings.Test2_Num, 0, 255, repeatFast8),
+        MENU_UINT8_FAST(txtSetting3, settings.Test3_Num, 0, 255, repeatFast8),
+        MENU_UINT8_FAST(txtSetting4, settings.Test4_Num, 0, 255, repeatFast8),
+        MENU_BOOL(txtSetting5, settings.Test5_OnnOff),
+        MENU_UINT8_FAST(txtSetting6, settings.Test6_Num, 0, 255, repeatFast8),
+        MENU_ACTION(txtExportLog, slog_export)
+};
 
-                        switch (pntrPos){case 1: currPage = MENU_ROOT; return;
-                        }
-                }
-                //otherwise check for pointer up or down button
-                doPointerNavigation();
+// id, title, items, parent, on enter, on loop, on leave
+constexpr MenuPage menuPages[] PROGMEM = {
+        {MENU_ROOT,     MENU_TITLE(txtMainMenu),     MENU_ITEMS(itemsRoot),     MENU_ROOT, nullptr,     nullptr,       nullptr},
+        {MENU_SUB1,     MENU_TITLE(txtContinuous),   MENU_ITEMS(itemsSub1),     MENU_ROOT, nullptr,     nullptr,       nullptr},
+        {MENU_SUB1_A,   MENU_TITLE(txtContinuous),   MENU_NO_ITEMS,             MENU_SUB1, toggleMode1, sessionLoop,   leaveSessionPage},
+        {MENU_SUB2,     MENU_TITLE(txtIntermittent), MENU_ITEMS(itemsSub2),     MENU_ROOT, nullptr,     nullptr,       nullptr},
+        {MENU_SUB2_A,   MENU_TITLE(txtIntermittent), MENU_NO_ITEMS,             MENU_SUB2, toggleMode2, sessionLoop,   leaveSessionPage},
+        {MENU_SUB3,     MENU_TITLE(txtDemoMode),     MENU_ITEMS(itemsSub3),     MENU_ROOT, nullptr,     nullptr,       nullptr},
+        {MENU_SUB3_A,   MENU_TITLE(txtDemoMode),     MENU_NO_ITEMS,             MENU_SUB3, toggleDemo,  sessionLoop,   leaveSessionPage},
+        {MENU_SETTINGS, MENU_TITLE(txtSettings),     MENU_ITEMS(itemsSettings), MENU_ROOT, nullptr,     nullptr,       sets_Save},
+        {MENU_STATUS,   MENU_TITLE(txtChannels),     MENU_NO_ITEMS,             MENU_ROOT, nullptr,     statusLoop,    nullptr}
+};
+MENU_CHECK(menuPages, MENU_PAGE_CNT);
 
-                //keep a specific pace
-                pacingWait();
-        }  
-}
 // ===========================================================
-// ||                  SUB MODE 1                         ||
+// ||                  MENU ENGINE                          ||
 //============================================================
-void page_MenuSub1_A(){
+void menuTask(){
 
-        //initializes menu pages
-        initMenuPages(F("CONTINUOUS"), 2 );
-
-        //inner loop
-        while (true){
-
-                //print the Display item when requested
-                if(updateAllitems){
-
-                        //print the visible item
-                        if(menuItemPrintable(1,1)){
-                                
-                                if (systemOn) 
-                                {
-                                        // If system is on, stop sterilization
-                                        sterilizationPaused = true;
-                                        systemOn = false;
-                                        remainingTime = modeEndTime - millis();
-                                        lcd.clear();
-                                        lcd.setCursor(0, 0);
-                                        lcd.print(F("System Interrupt"));
-                                        lcd.setCursor(1, 1);
-                                        lcd.print(F(" Press Back >>"));                                        
-                                        digitalWrite(VIBRATION_MOTOR_PIN, LOW);
-                                        digitalWrite(LED_GREEN, LOW);
-                                }
-                                else {
-                                        // If paused, resume sterilization
-                                        if (sterilizationPaused) {
-                                                modeEndTime = millis() + remainingTime;
-                                                systemOn = true;
-                                                sterilizationPaused = false;
-                                                lcd.setCursor(1, 1);
-                                                lcd.print(" 00 : ");
-                                                lcd.print(remainingTime / 1000); // Print remaining seconds on LCD
-                                                lcd.print(" : 00   ");
-                                                digitalWrite(VIBRATION_MOTOR_PIN, HIGH); // Activate Vibration Motor
-                                                digitalWrite(LED_GREEN, HIGH); //Activate Green LED
-                                                } 
-                                        else {
-                                                currentMode = 1;// Mode 1 selected
-                                                modeEndTime = millis() + MODE1_DURATION;
-                                                activateMode();           
-                                        }
-                                }
-
-                        }
-                }
-
-                //check system on and update countdown
-                check_system();
+        PT_BEGIN(menuPt);
 
-                if(isFlashChanged()){printPointer();}
+        //open the current page and step it until another page is selected
+        while(true){
+                menuEnter(currPage);
+                while(menuStep()){PT_YIELD(menuPt);}
+        }
 
-                //always clear update flags by this point
-                updateAllitems = false;
+        PT_END(menuPt);
+}
+void menuEnter(uint8_t id){
 
-                //capture the button down state
-                captureButtonDownState();
+        //take a RAM copy of the page descriptor
+        memcpy_P(&menuPage, &menuPages[id], sizeof menuPage);
 
-                //check for the ok button
-                if (btnBack.PressReleased()){currPage = MENU_SUB1; return;}
-                //otherwise check for pointer up or down button
-                doPointerNavigation();
+        //initializes menu pages
+        initMenuPages(menuPage.title, menuPage.titleLen, menuPage.itemCount);
 
-                //keep a specific pace
-                pacingWait();
+        // for the ROOT MENU we will recall last know position and off set of the display
+        if(id == MENU_ROOT){pntrPos = root_pntrPos; dispOffset = root_dispOffSet;}
 
-  
-        }
+        if(menuPage.onEnter){menuPage.onEnter();}
 }
-// ===========================================================
-// ||                  MENU SUB#2                            ||
-//============================================================
-
-void page_MenuSub2(){
-        
-        //initializes menu pages
-        initMenuPages(F("INTERMITTENT"), 3 );
-
-        //inner loop
-        while (true){
+bool menuStep(){
 
-                //print the sipalay item when requested
-                if(updateAllitems){
+        MenuItem item;
 
-                        //print the visible item
-                        if(menuItemPrintable(1,1)){lcd.print(F("START  "));}
-                        if(menuItemPrintable(1,2)){lcd.print(F("BACK   "));}
+        //print the display items when requested
+        if(updateAllitems){
 
+                //print the visible items
+                for(uint8_t i = 0; i < menuPage.itemCount; i++){
+                        if(menuItemPrintable(1, i + 1)){memcpy_P(&item, &menuPage.items[i], sizeof item); printItemLabel(&item);}
                 }
-        
-                if(isFlashChanged()){printPointer();}
-
-                //alwats clear update flags by this point
-                updateAllitems = false;
-
-                //capture the button down state
-                captureButtonDownState();
 
-                //check for the ok button
-                if(btnOk.PressReleased()){
+                printOffsetArrows();
+        }
 
-                        switch (pntrPos){
-                                case 1: currPage = MENU_SUB2_A; return;
-                                case 2: currPage = MENU_ROOT; return;
-                        }
-                }
-                else if(btnBack.PressReleased()){
+        //print the bound values when requested
+        if(updateAllitems || updateItemvalue){
 
-                        switch (pntrPos){case 1: currPage = MENU_ROOT; return;
-                        }
+                for(uint8_t i = 0; i < menuPage.itemCount; i++){
+                        memcpy_P(&item, &menuPage.items[i], sizeof item);
+                        if(item.kind >= MI_BOOL && menuItemPrintable(MENU_VALUE_COL, i + 1)){printItemValue(&item);}
                 }
-                //otherwise check for pointer up or down button
-                doPointerNavigation();
-
-                //keep a specific pace
-                pacingWait();
-        }  
-}
-// ===========================================================
-// ||                  SUB MODE 2                         ||
-//============================================================
-void page_MenuSub2_A(){
-
-        //initializes menu pages
-        initMenuPages(F("INTERMITTENT"), 2 );
-
-        //inner loop
-        while (true){
-
-                //print the sipalay item when requested
-                if(updateAllitems){
-
-                        if(menuItemPrintable(1,1)){
-                                
-                                if (systemOn) {
-                                        // If system is on, stop sterilization
-                                        sterilizationPaused = true;
-                                        systemOn = false;
-                                        remainingTime = modeEndTime - millis();
-                                        lcd.clear();
-                                        lcd.setCursor(0, 0);
-                                        lcd.print(F("System Interrupt"));
-                                        lcd.setCursor(1, 1);
-                                        lcd.print(F(" Press Back >>"));                                        
-                                        digitalWrite(VIBRATION_MOTOR_PIN, LOW);
-                                        digitalWrite(LED_GREEN, LOW);
-                                }
-                                else {
-                                        // If paused, resume sterilization
-                                        if (sterilizationPaused) {
-                                                modeEndTime = millis() + remainingTime;
-                                                systemOn = true;
-                                                sterilizationPaused = false;
-                                                lcd.setCursor(1, 1);
-                                                lcd.print(" 00 : ");
-                                                lcd.print(remainingTime / 1000); // Print remaining seconds on LCD
-                                                lcd.print(" : 00   ");
-                                                digitalWrite(VIBRATION_MOTOR_PIN, HIGH); // Activate Vibration Motor
-                                                digitalWrite(LED_GREEN, HIGH); // Activate LED Green
-                                                } 
-                                        else {
-                                                currentMode = 2;// Mode 2 selected
-                                                modeEndTime = millis() + MODE2_DURATION;
-                                                activateMode();           
-                                                }
-                                        }
-                                }
-                }
-
-                //check system on and update countdown
-                check_system();
-        
-                if(isFlashChanged()){printPointer();}
-
-                //alwats clear update flags by this point
-                updateAllitems = false;
-
-                //capture the button down state
-                captureButtonDownState();
-
-                //check for the ok button
-                if (btnBack.PressReleased()){currPage = MENU_SUB2; return;}
-                //otherwise check for pointer up or down button
-                doPointerNavigation();
-
-                //keep a specific pace
-                pacingWait();                 
         }
-}
 
-// ===========================================================
-// ||                  DEMO MODE                            ||
-//============================================================
+        //page specific work
+        if(menuPage.onLoop){menuPage.onLoop();}
 
-void page_MenuSub3(){
-        
-       //initializes menu pages
-        initMenuPages(F("DEMO MODE"), 3 );
+        if(isFlashChanged()){printPointer();}
 
-        //inner loop
-        while (true){
+        //always clear update flags by this point
+        updateAllitems = false;
+        updateItemvalue = false;
 
-                //print the sipalay item when requested
-                if(updateAllitems){
+        //capture the button down state
+        captureButtonDownState();
 
-                        //print the visible item
-                        if(menuItemPrintable(1,1)){lcd.print(F("START  "));}
-                        if(menuItemPrintable(1,2)){lcd.print(F("BACK   "));}
+        //check for the ok button on the selected item, otherwise the back button
+        uint8_t nextPage = menuPage.id;
+        if(menuPage.itemCount > 0){memcpy_P(&item, &menuPage.items[pntrPos - 1], sizeof item);} else {item.kind = MI_TEXT;}
 
+        if(btnOk.PressReleased()){
+                switch (item.kind){
+                        case MI_PAGE: nextPage = item.page; break;
+                        case MI_BACK: nextPage = menuPage.parent; break;
+                        case MI_ACTION: item.action(); break;
                 }
-        
-                if(isFlashChanged()){printPointer();}
+        }
+        else if(btnBack.PressReleased()){nextPage = menuPage.parent;}
 
-                //alwats clear update flags by this point
-                updateAllitems = false;
+        //leave the page when another page was selected
+        if(nextPage != menuPage.id){
 
-                //capture the button down state
-                captureButtonDownState();
+                //for the ROOT MENU we will save last know position and offset of the display
+                if(menuPage.id == MENU_ROOT){root_pntrPos = pntrPos; root_dispOffSet = dispOffset;}
 
-                                //check for the ok button
-                if(btnOk.PressReleased()){
+                if(menuPage.onLeave){menuPage.onLeave();}
+                currPage = (pageType)nextPage;
+                return false;
+        }
 
-                        switch (pntrPos){
-                                case 1: currPage = MENU_SUB3_A; return;
-                                case 2: currPage = MENU_ROOT; return;
-                        }
-                }
-                else if(btnBack.PressReleased()){currPage = MENU_ROOT; return;}
-                
-                //otherwise check for pointer up or down button
-                doPointerNavigation();
+        //otherwise check for pointer up or down button
+        doPointerNavigation();
+
+        //editing action based on selected item > MUST BE AFTER NAVIGATION TO ENSURE CORRECT SCREEN UPDATE!!
+        if(menuPage.itemCount > 0){
+                memcpy_P(&item, &menuPage.items[pntrPos - 1], sizeof item);
+                if(item.kind == MI_BOOL){adjustBoolean((bool *)item.value);}
+                else if(item.kind == MI_UINT8){adjustUint8_t((uint8_t *)item.value, item.min, item.max, item.repeat ? item.repeat : &repeatDefault);}
+        }
 
-                //keep a specific pace
-                pacingWait();
-        } 
+        return true;
 }
-// ===========================================================
-// ||                  SUB DEMO MODE                          ||
-//============================================================
-void page_MenuSub3_A(){
+void displayTask(){
 
-        //initializes menu pages
-        initMenuPages(F("DEMO MODE"), 2 );
-
-        //inner loop
-        while (true){
-
-                //print the sipalay item when requested
-                if(updateAllitems){
-
-                        //print the visible item
-                        if(menuItemPrintable(1,1)){
-                                
-                                if (systemOn) {
-                                        // If system is on, stop sterilization
-                                        sterilizationPaused = true;
-                                        systemOn = false;
-                                        remainingTime = modeEndTime - millis();
-                                        lcd.clear();
-                                        lcd.setCursor(0, 0);
-                                        lcd.print(F("System Interrupt"));
-                                        lcd.setCursor(1, 1);
-                                        lcd.print(F(" Press Back >>"));                                        
-                                        digitalWrite(VIBRATION_MOTOR_PIN, LOW);
-                                        digitalWrite(LED_GREEN, LOW);
-                                        }
-                                else {
-                                        // If paused, resume sterilization
-                                        if (sterilizationPaused) {
-                                                modeEndTime = millis() + remainingTime;
-                                                systemOn = true;
-                                                sterilizationPaused = false;
-                                                lcd.setCursor(1, 1);
-                                                lcd.print(" 00 : ");
-                                                lcd.print(remainingTime / 1000); // Print remaining seconds on LCD
-                                                lcd.print(" : 00   ");
-                                                digitalWrite(VIBRATION_MOTOR_PIN, HIGH); // Activate Vibration Motor
-                                                digitalWrite(LED_GREEN, HIGH); // Activate LED Green
-                                                } 
-                                        else {
-                                                currentMode = 3;// Mode 1 selected
-                                                modeEndTime = millis() + DEMO_DURATION;
-                                                activateMode();           
-                                        }
-                                }
-
-                        }
-                }
+        //send whatever changed on the display since the last pass
+        lcd.commit();
+}
+void gestureTask(){
 
-                //check system on and update countdown
-                check_system();
+        gest_tick();
 
-                if(isFlashChanged()){printPointer();}
+        //OK + BACK stops the sessions of all channels whatever page is open, the two releases are no menu actions
+        if(gest_readChord(chordStop)){
+                chordHeld = true;
+                stopAllSessions();
+        }
+}
+void powerTask(){
 
-                //always clear update flags by this point
-                updateAllitems = false;
+        //stay awake while the device is used or a session runs
+        if(SLEEP_AFTER_MS == 0 || sess_running() || millis() - lastActivityMs < SLEEP_AFTER_MS){return;}
 
-                //capture the button down state
-                captureButtonDownState();
+        //display and backlight off, the commands have to reach the display before the clocks stop
+        lcd.noBacklight();
+        lcdHw.noDisplay();
+        lcdHw.flush();
 
-                //check for the ok button
-                if (btnBack.PressReleased()){currPage = MENU_SUB3; return;}
-                //otherwise check for pointer up or down button
-                doPointerNavigation();
+        pwr_powerDown(wakePins, sizeof wakePins);
 
-                //keep a specific pace
-                pacingWait();
-        }  
+        //back on where we left off, the display kept its contents
+        lcdHw.display();
+        lcd.backlight();
+        wakePress = true;
+        lastActivityMs = millis();
 }
 
 // ===========================================================
-// ||                  MENU settings                            ||
+// ||                  MENU UVC                            ||
 //============================================================
-void page_MenuSettings(){
-        //initializes menu pages
-        initMenuPages(F("SETTINGS"), 7 );
-
-        //inner loop
-        while (true){
-
-                //print the sipalay item when requested
-                if(updateAllitems){
 
-                        //print the visible item
-                        if(menuItemPrintable(1,1)){lcd.print(F("Setting 1 = "));}
-                        if(menuItemPrintable(1,2)){lcd.print(F("Setting 2 = "));}
-                        if(menuItemPrintable(1,3)){lcd.print(F("Setting 3 = "));}
-                        if(menuItemPrintable(1,4)){lcd.print(F("Setting 4 = "));}
-                        if(menuItemPrintable(1,5)){lcd.print(F("Setting 5 = "));}
-                        if(menuItemPrintable(1,6)){lcd.print(F("Setting 6 = "));}
-
-                }
-                if(updateAllitems || updateItemvalue){
-
-                        if(menuItemPrintable(13,1)){printOnOff(settings.Test1_OnOff);}
-                        if(menuItemPrintable(13,2)){printUint32_tAtWidth(settings.Test2_Num, 3, ' ', false);}
-                        if(menuItemPrintable(13,3)){printUint32_tAtWidth(settings.Test3_Num, 3, ' ', false);}
-                        if(menuItemPrintable(13,4)){printUint32_tAtWidth(settings.Test4_Num, 3, ' ', false);}
-                        if(menuItemPrintable(13,5)){printOnOff(settings.Test5_OnnOff);}
-                        if(menuItemPrintable(13,6)){printUint32_tAtWidth(settings.Test6_Num, 3, ' ', false);}
-                }
-                if(isFlashChanged()){printPointer();}
-
-                //always clear update flags by this point
-                updateAllitems = false;
-                updateItemvalue = false;
-
-                //capture the button down state
-                captureButtonDownState();
-
-                //go back to menu layer
-                if(btnBack.PressReleased()){currPage = MENU_ROOT; sets_Save(); return;}
-                
-                //otherwise check for pointer up or down button
-                doPointerNavigation();
-
-                //editing action based on selected item > MUST BE AFTER NAVIGATION TO ENSURE CORRECT SCREEN UPDATE!!
-                switch (pntrPos)
-                {
-                        case 1: adjustBoolean(&settings.Test1_OnOff); break;
-                        case 2: adjustUint8_t(&settings.Test2_Num, 0, 255); break;
-                        case 3: adjustUint8_t(&settings.Test3_Num, 0, 255); break;
-                        case 4: adjustUint8_t(&settings.Test4_Num, 0, 255); break;
-                        case 5: adjustBoolean(&settings.Test5_OnnOff); break;
-                        case 6: adjustUint8_t(&settings.Test6_Num, 0, 255); break;
-                
-                }
-
-                //if(btnOk.LongPressed()){ sets_SetDefaults(); updateAllitems = true ;}
-                //keep a specific pace
-                pacingWait();
-        }  
+// Function to start the selected mode on the selected channel, or to pause / resume the channel when its session runs
+void toggleMode(int mode){
+
+        //the session page shows the countdown and the end of the session of its channel, its OK gestures control that channel
+        if(!sessionPageOpen){sessionChannel = selChannel - 1;}
+        sessionPageOpen = true;
+        sessionMode = mode;
+        uint8_t ch = sessionChannel;
+
+        switch (sess_state(ch)) {
+                case SESS_RUNNING:
+                        // If system is on, stop sterilization - the page shows the time left once the notification is gone
+                        sess_pause(ch);
+                        channelPauses[ch]++;
+                        lcd.notify(PSTR("System Interrupt"), PSTR("Paused"), NOTE_MS);
+                        lcd.setCursor(1, 1);
+                        lcd.print(F(" PAUSED "));
+                        printSeconds(sess_remainingMs(ch));
+                        lcd.print(F("s      "));
+                        break;
+                case SESS_PAUSED:
+                        // If paused, resume sterilization
+                        sess_resume(ch);
+                        lcd.setCursor(1, 1);
+                        lcd.print(" 00 : ");
+                        printSeconds(sess_remainingMs(ch)); // Print remaining seconds on LCD
+                        lcd.print(" : 00   ");
+                        break;
+                default:
+                        channelMode[ch] = mode;
+                        channelPauses[ch] = 0;
+                        wave_select(ch, (const WaveStep *)pgm_read_ptr(&modePatterns[mode]));
+                        sess_start(ch, pgm_read_word(&modeDurations[mode]));
+                        activateMode();
+        }
 }
+void toggleMode1(){toggleMode(1);}
+void toggleMode2(){toggleMode(2);}
+void toggleDemo(){toggleMode(3);}
 
-// ===========================================================
-// ||                  MENU UVC                            ||
-//============================================================
+
+// The motor of the channel plays the envelope of its mode while the session outputs are on, it is stopped on the session end tick
+void motorOutput(uint8_t ch, bool on){if(on){wave_start(ch);} else{wave_stop(ch);}}
 
 // Function to activate the selected mode
 void activateMode() {
 
-        systemOn = true; // Turn on the system
-        sterilizationPaused = false;
-        
         lcd.setCursor(1, 1);
-        lcd.print("MODE ");
-        lcd.print(currentMode);
-        lcd.print(": ");
-        lcd.print((modeEndTime - millis()) / 1000); // Print initial remaining seconds on LCD
-        lcd.print("s   ");
-        digitalWrite(VIBRATION_MOTOR_PIN, HIGH); // Activate UV-C lights
-        digitalWrite(LED_GREEN, HIGH); //Activate LED Green
+        // channel (1-4) and mode (1-3) are single digits, written as characters without Print's division
+        lcd.print(F("CH"));
+        lcd.write('1' + sessionChannel);
+        lcd.print(F(" MODE "));
+        lcd.write('0' + channelMode[sessionChannel]);
+        lcd.print(F(": "));
+        printSeconds(sess_remainingMs(sessionChannel)); // Print initial remaining seconds on LCD
+        lcd.print("s");
 }
 
-// Function to display "Sterilization Complete" on the LCD
+// Function to display "Physiotherapy Complete" over the page for NOTE_MS
 void displayPhysiotherapyComplete() {
-        lcd.clear();
-        lcd.setCursor(1, 0);
-        lcd.print("Physiotherapy");
-        lcd.setCursor(4, 1);
-        lcd.print("Complete");
-        delay(1000);
-        lcd.clear();
-        lcd.setCursor(3, 1);
-        lcd.print("Press Back >>");
+        lcd.notify(PSTR("Physiotherapy"), PSTR("Complete"), NOTE_MS);
 }
 // Function to deactivate the system
-void deactivateSystem() {
-        systemOn = false; // Turn off the system
-        currentMode = 0; // Reset mode to Off
-        digitalWrite(VIBRATION_MOTOR_PIN, LOW);
-        digitalWrite(LED_GREEN, LOW);
-        lcd.clear();
-        lcd.setCursor(0, 0);
-        lcd.print("________________");
-        delay(1000);
+void deactivateSystem(uint8_t ch, uint8_t end) {
+        // Log the session that ends, the time it ran is the planned time less what was left
+        if (channelMode[ch] != 0) {
+                SlogRecord r;
+                r.channel = ch;
+                r.mode = channelMode[ch];
+                r.end = end;
+                r.pauses = channelPauses[ch];
+                r.plannedS = pgm_read_word(&modeDurations[channelMode[ch]]);
+                r.actualS = r.plannedS - sess_remainingS(ch);
+                slog_append(&r);
+        }
+        sess_stop(ch); // Turn off the channel and its outputs
+        channelMode[ch] = 0; // Reset mode to Off
 }
-void check_system(){
+void showCountdown(){
 
-        // Update the countdown display for Mode 1
-        if (systemOn && (currentMode == 1 || currentMode == 2 || currentMode == 3) ) {
-        unsigned long currentTime = millis();
-                if (currentTime >= modeEndTime) {
-                deactivateSystem();
-                displayPhysiotherapyComplete();
-        } 
-        else {
+        // Update the countdown display on every second of a running session, the end of the session is handled by therapyTask()
+        if (sess_state(sessionChannel) == SESS_RUNNING && sess_takeSecond(sessionChannel)) {
                 lcd.setCursor(1, 1);
                 lcd.print(" 00 : ");
-                //lcd.print(currentMode);
-                //lcd.print(": ");
-                lcd.print((modeEndTime - currentTime) / 1000); // Print remaining seconds on LCD
+                printSeconds(sess_remainingMs(sessionChannel)); // Print remaining seconds on LCD
                 lcd.print(" : 00   ");
-                }
+        }
+}
+void sessionLoop(){
+
+        showCountdown();
+
+        //OK alone controls the session of the page channel: press to pause or resume (or start again once complete),
+        //double press to start over with the full time, hold to stop
+        switch(gest_read(gestOk)){
+                case GESTURE_SINGLE:
+                        toggleMode(sessionMode);
+                        break;
+                case GESTURE_DOUBLE:
+                        deactivateSystem(sessionChannel, SLOG_RESTARTED);
+                        toggleMode(sessionMode);
+                        break;
+                case GESTURE_LONG:
+                        if(sess_state(sessionChannel) != SESS_IDLE){stopSession(sessionChannel);}
+                        break;
+        }
+}
+void stopSession(uint8_t ch){
+
+        deactivateSystem(ch, SLOG_STOPPED);
+        lcd.notify(PSTR("Session Stopped"), nullptr, NOTE_MS);
+        if(sessionPageOpen && ch == sessionChannel){lcd.setCursor(0, 1); lcd.print(F("   Press Back >>"));}
+}
+void stopAllSessions(){
+
+        //one notification for all the channels stopped
+        bool stopped = false;
+        for(uint8_t ch = 0; ch < MOTOR_CHANNELS; ch++){
+                if(sess_state(ch) != SESS_IDLE){deactivateSystem(ch, SLOG_STOPPED); stopped = true;}
+        }
+        if(!stopped){return;}
+        lcd.notify(PSTR("Session Stopped"), nullptr, NOTE_MS);
+        if(sessionPageOpen){lcd.setCursor(0, 1); lcd.print(F("   Press Back >>"));}
+}
+void leaveSessionPage(){sessionPageOpen = false;}
+uint8_t completeChannel(){
+
+        for(uint8_t ch = 0; ch < MOTOR_CHANNELS; ch++){
+                if(sess_state(ch) == SESS_COMPLETE){return ch;}
+        }
+        return MOTOR_CHANNELS;
+}
+void therapyTask(){
+
+        PT_BEGIN(therapyPt);
+
+        while(true){
+
+                //wait for a running session to end, whatever page the menu is on - the session timer
+                //has switched the outputs of the channel off on the tick the time ran out already
+                PT_WAIT_UNTIL(therapyPt, (doneChannel = completeChannel()) < MOTOR_CHANNELS);
+                deactivateSystem(doneChannel, SLOG_COMPLETE);
+
+                //the end of the session shows over whatever page is open, a second per message, and the page
+                //comes back afterwards - the buttons and the menu keep running meanwhile
+                lcd.notify(PSTR("________________"), nullptr, NOTE_MS);
+                displayPhysiotherapyComplete();
+                if(sessionPageOpen && doneChannel == sessionChannel){lcd.setCursor(0, 1); lcd.print(F("   Press Back >>"));}
+        }
+
+        PT_END(therapyPt);
+}
+void statusLoop(){
+
+        //every channel in 4 cells, the display shadow only sends the cells that changed
+        lcd.setCursor(0, 1);
+        for(uint8_t ch = 0; ch < MOTOR_CHANNELS; ch++){printChannelStatus(ch);}
+}
+void printChannelStatus(uint8_t ch){
+
+        //running '>' or paused '=' with the seconds left, '-' when idle
+        switch(sess_state(ch)){
+                case SESS_RUNNING: lcd.write('>'); printSecondsAtWidth(sess_remainingMs(ch), 3); break;
+                case SESS_PAUSED: lcd.write('='); printSecondsAtWidth(sess_remainingMs(ch), 3); break;
+                default: lcd.print(F("-   "));
         }
 }
 
@@ -767,17 +656,23 @@ void check_system(){
 // ||               TOOLS - MENU INTERVALS                  ||
 //============================================================
 
-void initMenuPages(String title, uint8_t itemCount ){
+void initMenuPages(const char *title, uint8_t titleLen, uint8_t itemCount){
 
         lcd.clear();
 
         lcd.setCursor(0,0);
 
-        uint8_t fillCnt = (DISP_CHAR_WIDTH - title.length()) / 2;
-        if(fillCnt > 0){for(uint8_t i = 0; i< fillCnt; i++){lcd.print(F("\03"));}}
-        lcd.print(title);
-        if ((title.length() % 2 ) == 1){fillCnt++;}
-        if(fillCnt > 0){for(uint8_t i = 0; i < fillCnt; i++){lcd.print(F("\04"));}}
+        //make sure the menu glyphs are in CGRAM before anything is drawn with them
+        glyphs.load(menuGlyphs, sizeof menuGlyphs);
+
+        //centre the title between the fill characters, the title is streamed straight from flash
+        uint8_t fillCnt = (DISP_CHAR_WIDTH - titleLen) / 2;
+        printChars(fillCnt, glyphs.code(GLYPH_F1));
+        lcd.print(FPSTR(title));
+        printChars(DISP_CHAR_WIDTH - titleLen - fillCnt, glyphs.code(GLYPH_F2));
+
+        //no gesture made on the previous page is meant for this one
+        gest_clear();
 
         //clear all button states
         btnUp.ClearWasDown();
@@ -804,27 +699,46 @@ void initMenuPages(String title, uint8_t itemCount ){
 
         // force a full update
         updateAllitems = true;
-
-        //capture start time
-        loopStartMs = millis();
 }           
 void captureButtonDownState(){
 
-        btnUp.CaptureDownState();
-        btnDown.CaptureDownState();
-        btnOk.CaptureDownState();
-        btnBack.CaptureDownState();
-        btnMinus.CaptureDownState();
-        btnPlus.CaptureDownState();
+        //hand the presses latched by the button bank to the buttons
+        bool pressed = PressButtonBase::Dispatch();
+
+        //the press that woke the device up is not a menu action, nothing is captured until every button is up again
+        if(wakePress){
+                btnUp.ClearWasDown(); btnDown.ClearWasDown(); btnOk.ClearWasDown(); btnBack.ClearWasDown(); btnMinus.ClearWasDown(); btnPlus.ClearWasDown();
+                if(btnUp.IsUp() && btnDown.IsUp() && btnOk.IsUp() && btnBack.IsUp() && btnMinus.IsUp() && btnPlus.IsUp()){wakePress = false;}
+                return;
+        }
+
+        pressed |= btnUp.CaptureDownState();
+        pressed |= btnDown.CaptureDownState();
+        pressed |= btnOk.CaptureDownState();
+        pressed |= btnBack.CaptureDownState();
+        pressed |= btnMinus.CaptureDownState();
+        pressed |= btnPlus.CaptureDownState();
+
+        //a chord, or a long press of OK on a session page, belongs to the gestures - its release is no menu action
+        if(chordHeld){
+                btnOk.ClearWasDown(); btnBack.ClearWasDown();
+                if(btnOk.IsUp() && btnBack.IsUp()){chordHeld = false;}
+        }
+        if(sessionPageOpen && gest_held(gestOk)){btnOk.ClearWasDown();}
+
+        //a pressed button keeps the device awake
+        if(pressed){lastActivityMs = millis();}
 }                                  
 void adjustBoolean(boolean *v){
         if(btnPlus.PressReleased() || btnMinus.PressReleased()){*v = !*v; updateItemvalue = true;}
 }                                    
-void adjustUint8_t(uint8_t *v, uint8_t min, uint8_t max){
-        
-        if (btnPlus.RepeatCnt == 0 && btnMinus.Repeated()){if(*v > min){*v = *v - 1; updateItemvalue = true;}}
+void adjustUint8_t(uint8_t *v, uint8_t min, uint8_t max, const RepeatProfile *profile){
 
-        if (btnMinus.RepeatCnt == 0 && btnPlus.Repeated()){if(*v < max){*v = *v + 1; updateItemvalue = true;}}
+        //the profile sets how fast and by how much a held button moves the value, clamped to min and max
+        uint16_t step;
+        if (btnPlus.RepeatCnt() == 0 && (step = btnMinus.Repeated(profile))){if(*v > min){*v = *v - min > step ? *v - step : min; updateItemvalue = true;}}
+
+        if (btnMinus.RepeatCnt() == 0 && (step = btnPlus.Repeated(profile))){if(*v < max){*v = max - *v > step ? *v + step : max; updateItemvalue = true;}}
 }  
 void doPointerNavigation(){
 
@@ -871,14 +785,6 @@ bool isFlashChanged(){
         //decrease the flash counter and send a negative response
         else {flashCntr--;return false;}
 }                                          
-void pacingWait(){
-
-        //do the pacing wait
-        while(millis() - loopStartMs < PACING_MS){delay(1);}
-
-        //capture start time
-        loopStartMs = millis();
-}
                                               
 bool menuItemPrintable(uint8_t xPos, uint8_t yPos){
 
@@ -911,7 +817,7 @@ void printPointer(){
         lcd.setCursor(0, pntrPos- dispOffset);
 
         //show the pointer if set
-        if(flashIsOn){lcd.print(F("\01"));}
+        if(flashIsOn){lcd.write(glyphs.code(GLYPH_AR));}
 
         //otherwise hide the pointer
         else{lcd.print(F(" "));}
@@ -919,11 +825,25 @@ void printPointer(){
 void printOffsetArrows(){
 
         lcd.setCursor(DISP_CHAR_WIDTH - 1, 1);
-        if(dispOffset > 0 ){ lcd.print(F("\01"));} else{lcd.print(F(" "));}
+        if(dispOffset > 0 ){ lcd.write(glyphs.code(GLYPH_UP));} else{lcd.print(F(" "));}
 
         lcd.setCursor(DISP_CHAR_WIDTH - 1, DISP_ITEM_ROWS);
-        if(itemCnt > DISP_ITEM_ROWS && itemCnt - DISP_ITEM_ROWS > dispOffset){lcd.print(F("\02"));} else{lcd.print(F(" "));}
+        if(itemCnt > DISP_ITEM_ROWS && itemCnt - DISP_ITEM_ROWS > dispOffset){lcd.write(glyphs.code(GLYPH_DN));} else{lcd.print(F(" "));}
 }                                       
+void printItemLabel(const MenuItem *item){
+
+        lcd.print(FPSTR(item->label));
+
+        //pad up to the value column, or up to the arrows column for items without a value
+        uint8_t endCol = item->kind >= MI_BOOL ? MENU_VALUE_COL : DISP_CHAR_WIDTH - 1;
+        uint8_t len = item->labelLen + 1;
+        if(len < endCol){printChars(endCol - len, ' ');}
+}
+void printItemValue(const MenuItem *item){
+
+        if(item->kind == MI_BOOL){printOnOff(*(bool *)item->value);}
+        else{printUint32_tAtWidth(*(uint8_t *)item->value, 3, ' ', false);}
+}
 void printOnOff(bool val){
 
         if(val){lcd.print(F("ON "));}
@@ -932,41 +852,35 @@ void printOnOff(bool val){
 
 void printChars(uint8_t cnt, char c){
 
-        //only bother if char count is more than zero
-        if(cnt > 0 ){
-
-                // build the character array with the single character ready for printing
-                char cc[] = " "; cc[0] = c;
-
-                //print "cnt" number of the specified character
-                for(uint8_t i = 1; i<= cnt; i++){lcd.print(cc);}
-        }
-}
-uint8_t getUint32_tCharCnt(uint32_t value){
-
-        //value id zero then return 1
-        if(value == 0){return 1;}
-
-        //setup the working variables
-        uint32_t tensCalc = 10;uint8_t cnt = 1;
-
-        //keep increasing the tensCalc value and counting the digits for as long as the tensCalc value is lower than the value
-        while(tensCalc <= value && cnt < 20){tensCalc *=10; cnt += 1;}
-
-        //return the result!
-        return cnt;
+        //write the character one by one (a custom character may be code 0, which print() would stop at)
+        for(uint8_t i = 0; i < cnt; i++){lcd.write(c);}
 }
 void printUint32_tAtWidth(uint32_t value, uint8_t width, char c, boolean isRight){
 
-        uint8_t numChars = getUint32_tCharCnt(value);
+        //the field never needs to be wider than the display
+        if(width > DISP_CHAR_WIDTH){width = DISP_CHAR_WIDTH;}
 
-        if(isRight){printChars(width- numChars, c);}
+        //format the padded field without any division and send it in one go
+        char buf[DISP_CHAR_WIDTH];
+        uint8_t len = numfmt_u32(buf, value, width, c, isRight);
+        lcd.write((const uint8_t *)buf, len);
+} 
 
-        lcd.print(value);
+void printSeconds(uint32_t ms){
 
-        if(!isRight){printChars(width-numChars,c);}
-} 
+        //format the milliseconds with at least 4 digits and drop the last 3, no division needed
+        char buf[NUMFMT_U32_DIGITS];
+        uint8_t len = numfmt_u32(buf, ms, 4, '0', true);
+        lcd.write((const uint8_t *)buf, len - 3);
+}
+void printSecondsAtWidth(uint32_t ms, uint8_t width){
 
+        //the same digits, spaces in front up to the width
+        char buf[NUMFMT_U32_DIGITS];
+        uint8_t len = numfmt_u32(buf, ms, 4, '0', true) - 3;
+        if(len < width){printChars(width - len, ' ');}
+        lcd.write((const uint8_t *)buf, len);
+}
 // ===========================================================
 // ||               TOOLS - SETTINGS                          ||
 //============================================================
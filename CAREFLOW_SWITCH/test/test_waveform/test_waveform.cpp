@@ -0,0 +1,141 @@
+#include <Arduino.h>
+#include <unity.h>
+#include <avr/sleep.h>
+#include <Waveform.h>
+
+// Plays a test envelope on the OC2A channel (pin 11) with the real Timer2 and follows OCR2A: every
+// level change is a step boundary, and the time between two of them is the length of the step.
+// Run under simavr (pio test -e simavr), it needs no hardware.
+
+#define PIN_OC2A 11
+#define TICK_US (WAVE_TICK_DIV * 1024UL)        //one envelope tick, WAVE_TICK_DIV Timer2 overflows of 1.024ms
+#define SLACK_US 300UL                          //polling and micros() resolution
+
+//three steps, the middle one off, then it starts over
+const WaveStep waveTest[] PROGMEM = {{10, 2}, {0, 1}, {200, 3}, {0, 0}};
+
+static uint32_t changedUs;                      //micros() of the last level change seen
+
+//waits for OCR2A to change, true when it did within timeoutUs - changedUs is when
+static bool nextLevel(uint32_t timeoutUs){
+
+    uint8_t level = OCR2A;
+    uint32_t start = micros();
+    while(OCR2A == level){
+        if(micros() - start > timeoutUs){return false;}
+    }
+    changedUs = micros();
+    return true;
+}
+
+//the step that just started has the level, the step before lasted ticks
+static void assertStep(uint8_t level, uint8_t ticks){
+
+    uint32_t from = changedUs;
+    TEST_ASSERT_TRUE_MESSAGE(nextLevel(ticks * TICK_US + TICK_US), "no step boundary");
+    TEST_ASSERT_EQUAL_UINT8(level, OCR2A);
+    TEST_ASSERT_UINT32_WITHIN(SLACK_US, ticks * TICK_US, changedUs - from);
+
+    //a level above 0 is on the pin, level 0 leaves it low
+    TEST_ASSERT_EQUAL(level > 0, (TCCR2A & _BV(COM2A1)) != 0);
+    if(level == 0){TEST_ASSERT_EQUAL(LOW, digitalRead(PIN_OC2A));}
+}
+
+void setUp(){
+    wave_init(0, PIN_OC2A);
+    wave_select(0, waveTest);
+}
+
+void tearDown(){
+    wave_stop(0);
+}
+
+//selecting loads the first step without starting the channel
+void test_select_loads_first_step(){
+    TEST_ASSERT_TRUE(wave_hardware(0));
+    TEST_ASSERT_EQUAL_UINT8(10, OCR2A);
+    TEST_ASSERT_FALSE(TCCR2A & _BV(COM2A1));
+    TEST_ASSERT_EQUAL_UINT8(0, wave_level(0));
+}
+
+//the levels and lengths of every step, over two runs of the table
+void test_step_boundaries_and_repeat(){
+
+    wave_start(0);
+    TEST_ASSERT_TRUE(TCCR2A & _BV(COM2A1));
+    TEST_ASSERT_EQUAL_UINT8(10, wave_level(0));
+
+    //the first boundary only syncs, the tick divider kept running from before the start
+    TEST_ASSERT_TRUE(nextLevel(3 * TICK_US));
+    TEST_ASSERT_EQUAL_UINT8(0, OCR2A);
+
+    assertStep(200, 1);
+    assertStep(10, 3);          //end of the table, it starts over
+    assertStep(0, 2);
+    assertStep(200, 1);
+    assertStep(10, 3);
+}
+
+//a stopped channel keeps its step and the ticks left of it, a start plays the rest of the step
+void test_stop_and_start_continue_the_step(){
+
+    wave_start(0);
+    TEST_ASSERT_TRUE(nextLevel(3 * TICK_US));
+    TEST_ASSERT_TRUE(nextLevel(2 * TICK_US));
+    TEST_ASSERT_EQUAL_UINT8(200, OCR2A);
+    uint32_t stepStart = changedUs;
+
+    //half way into the 3 tick step
+    while(micros() - stepStart < 3 * TICK_US / 2){}
+    wave_stop(0);
+    uint32_t played = micros() - stepStart;
+
+    TEST_ASSERT_FALSE(TCCR2A & _BV(COM2A1));
+    TEST_ASSERT_EQUAL(LOW, digitalRead(PIN_OC2A));
+    TEST_ASSERT_EQUAL_UINT8(0, wave_level(0));
+
+    //nothing moves while stopped
+    TEST_ASSERT_FALSE(nextLevel(10 * TICK_US));
+    TEST_ASSERT_EQUAL_UINT8(200, OCR2A);
+
+    //the rest of the step, then the table goes on from its start - Timer2 kept counting while
+    //stopped, so the overflow the stop fell into can count once more or once less
+    uint32_t resumed = micros();
+    wave_start(0);
+    TEST_ASSERT_TRUE(TCCR2A & _BV(COM2A1));
+    TEST_ASSERT_EQUAL_UINT8(200, wave_level(0));
+    TEST_ASSERT_TRUE(nextLevel(3 * TICK_US));
+    TEST_ASSERT_EQUAL_UINT8(10, OCR2A);
+    TEST_ASSERT_UINT32_WITHIN(SLACK_US + 1024UL, 3 * TICK_US - played, changedUs - resumed);
+}
+
+//stopped in a level 0 step, the start does not connect the pin before a level above 0 comes
+void test_start_in_off_step_stays_disconnected(){
+
+    wave_start(0);
+    TEST_ASSERT_TRUE(nextLevel(3 * TICK_US));
+    TEST_ASSERT_EQUAL_UINT8(0, OCR2A);
+    wave_stop(0);
+    wave_start(0);
+    TEST_ASSERT_FALSE(TCCR2A & _BV(COM2A1));
+    TEST_ASSERT_EQUAL(LOW, digitalRead(PIN_OC2A));
+
+    assertStep(200, 1);
+}
+
+void setup(){
+
+    UNITY_BEGIN();
+    RUN_TEST(test_select_loads_first_step);
+    RUN_TEST(test_step_boundaries_and_repeat);
+    RUN_TEST(test_stop_and_start_continue_the_step);
+    RUN_TEST(test_start_in_off_step_stays_disconnected);
+    UNITY_END();
+
+    //simavr quits when the MCU sleeps with interrupts off
+    Serial.flush();
+    cli();
+    sleep_cpu();
+}
+
+void loop(){}
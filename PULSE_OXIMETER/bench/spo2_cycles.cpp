@@ -0,0 +1,113 @@
+// Spo2 cost in CPU cycles per result at 25 samples per result - spo2_calc() over the window against 25 x spo2_push()
+// and one spo2_read(), on a made up pulse wave so no sensor is needed
+// build and run in simavr, no board needed (the results come out on the console):  pio run -e spo2_bench -t upload
+// on a board, flash .pio/build/spo2_bench/firmware.hex as the sketch is and watch the serial monitor at 115200
+//
+// Timer1 runs at the CPU clock and counts the cycles, its overflows are added up in an interrupt. The millis
+// interrupt is off while counting, the results are sent afterwards.
+#include <Arduino.h>
+#include <avr/sleep.h>
+#include <Spo2.h>
+
+#define SAMPLE_RING 128
+#define WINDOW_LEN 100
+#define UPDATE_LEN 25
+#define RESULTS 40              //results counted of each
+
+spo2_sample_t irRing[SAMPLE_RING];
+spo2_sample_t redRing[SAMPLE_RING];
+uint16_t ringHead;
+uint16_t phase;                 //of the pulse wave, 1/256 of a beat
+uint16_t noise = 1;
+
+volatile uint16_t overflows;
+volatile int32_t sink;
+
+ISR(TIMER1_OVF_vect){overflows++;}
+
+//cycles since the count started
+uint32_t cycles(){
+
+    uint8_t sreg = SREG;
+    cli();
+    uint16_t t = TCNT1;
+    uint16_t o = overflows;
+    if((TIFR1 & _BV(TOV1)) && t < 0x8000){o++;}
+    SREG = sreg;
+    return ((uint32_t)o << 16) | t;
+}
+
+//next sample of a 80bpm pulse wave with some noise into the rings
+void nextSample(){
+
+    phase += 256 * 80 / 60 / 25;
+    uint8_t p = phase;
+    int16_t pulse = p < 77 ? (int32_t)p * 600 / 77 : (int32_t)(255 - p) * 600 / 178;
+    noise = noise * 25173 + 13849;
+    int16_t n = (noise >> 11) & 31;
+    irRing[ringHead] = 50000 + pulse + n;
+    redRing[ringHead] = 40000 + pulse * 2 / 3 + n;
+    ringHead = (ringHead + 1) & (SAMPLE_RING - 1);
+}
+
+void setup(){
+
+    Serial.begin(115200);
+
+    TCCR1A = 0;
+    TCCR1B = _BV(CS10);
+    TIMSK1 = _BV(TOIE1);
+
+    int32_t spo2, heartRate;
+    int8_t spo2Valid, hrValid;
+    uint32_t batch = 0, stream = 0, pushMax = 0;
+
+    for(uint16_t i = 0; i < WINDOW_LEN; i++){nextSample();}
+
+    //the same samples through both, only the calculation is counted
+    spo2_begin(irRing, redRing, SAMPLE_RING - 1, WINDOW_LEN, 0);
+    for(uint16_t i = 0; i < WINDOW_LEN; i++){spo2_push();}
+    uint8_t timer0 = TIMSK0;
+    TIMSK0 = 0;
+    for(uint8_t r = 0; r < RESULTS; r++){
+        for(uint8_t i = 0; i < UPDATE_LEN; i++){
+            nextSample();
+            uint32_t t = cycles();
+            spo2_push();
+            t = cycles() - t;
+            stream += t;
+            if(t > pushMax){pushMax = t;}
+        }
+        uint32_t t = cycles();
+        spo2_read(&spo2, &spo2Valid, &heartRate, &hrValid);
+        stream += cycles() - t;
+        sink = spo2 + heartRate;
+
+        Spo2Window w = {irRing, redRing, SAMPLE_RING - 1, (uint16_t)((ringHead - WINDOW_LEN) & (SAMPLE_RING - 1)), WINDOW_LEN};
+        t = cycles();
+        spo2_calc(&w, &spo2, &spo2Valid, &heartRate, &hrValid);
+        batch += cycles() - t;
+        sink = spo2 + heartRate;
+    }
+    TIMSK0 = timer0;
+
+    Serial.print(F("spo2_calc(): "));
+    Serial.print(batch / RESULTS);
+    Serial.println(F(" cycles per result"));
+    Serial.print(F("spo2_push() x 25 + spo2_read(): "));
+    Serial.print(stream / RESULTS);
+    Serial.print(F(" cycles per result, slowest push "));
+    Serial.print(pushMax);
+    Serial.println(F(" cycles"));
+    Serial.print(F("last result HR "));
+    Serial.print(heartRate);
+    Serial.print(F(" SPO2 "));
+    Serial.println(spo2);
+
+    //simavr quits when the MCU sleeps with interrupts off
+    Serial.flush();
+    cli();
+    sleep_cpu();
+}
+
+void loop(){}
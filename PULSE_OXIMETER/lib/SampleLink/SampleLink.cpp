@@ -0,0 +1,83 @@
+#include "SampleLink.h"
+#include <util/crc16.h>
+
+static uint8_t _Seq;                        //sequence number of the next frame
+static uint8_t _Payload[LINK_MAX_PAYLOAD];  //sample frame being filled, the count goes in first
+static uint8_t _Len;                        //payload bytes so far
+static uint32_t _Prev[2];                   //red and IR of the sample before
+
+//3 bytes of v, low byte first
+static uint8_t *put24(uint8_t *p, uint32_t v){
+
+    p[0] = v;
+    p[1] = v >> 8;
+    p[2] = v >> 16;
+    return p + 3;
+}
+
+//sends one frame of the given type, the CRC covers the type, the sequence, the length and the payload
+static void send(uint8_t type, const uint8_t *payload, uint8_t len){
+
+    uint8_t head[5] = {LINK_SYNC0, LINK_SYNC1, type, _Seq++, len};
+    uint16_t crc = 0xFFFF;
+    for(uint8_t i = 2; i < sizeof(head); i++){crc = _crc_ccitt_update(crc, head[i]);}
+    for(uint8_t i = 0; i < len; i++){crc = _crc_ccitt_update(crc, payload[i]);}
+    uint8_t tail[2] = {(uint8_t)crc, (uint8_t)(crc >> 8)};
+
+    Serial.write(head, sizeof(head));
+    Serial.write(payload, len);
+    Serial.write(tail, sizeof(tail));
+}
+
+//new stream: sequence from 0, no samples pending
+void link_begin(){
+
+    _Seq = 0;
+    _Len = 0;
+}
+
+//adds a sample, a sample frame goes out every LINK_FRAME_SAMPLES of them
+void link_sample(uint32_t red, uint32_t ir){
+
+    uint32_t v[2] = {red, ir};
+
+    //the first sample of a frame is absolute
+    if(_Len == 0){
+        _Payload[0] = 1;
+        uint8_t *p = put24(put24(&_Payload[1], red), ir);
+        _Len = p - _Payload;
+    }
+    else{
+        _Payload[0]++;
+        for(uint8_t c = 0; c < 2; c++){
+            int32_t d = (int32_t)(v[c] - _Prev[c]);
+            if(d >= -127 && d <= 127){_Payload[_Len++] = (int8_t)d;}
+            else{
+                _Payload[_Len++] = LINK_ESCAPE;
+                put24(&_Payload[_Len], v[c]);
+                _Len += 3;
+            }
+        }
+    }
+    _Prev[0] = red;
+    _Prev[1] = ir;
+
+    if(_Payload[0] == LINK_FRAME_SAMPLES){link_flush();}
+}
+
+//sends the pending samples, then the result
+void link_result(int32_t heartRate, int8_t hrValid, int32_t spo2, int8_t spo2Valid){
+
+    link_flush();
+    uint8_t r[6] = {(uint8_t)heartRate, (uint8_t)(heartRate >> 8), (uint8_t)hrValid,
+                    (uint8_t)spo2, (uint8_t)(spo2 >> 8), (uint8_t)spo2Valid};
+    send(LINK_RESULT, r, sizeof(r));
+}
+
+//sends the pending samples now
+void link_flush(){
+
+    if(_Len == 0){return;}
+    send(LINK_SAMPLES, _Payload, _Len);
+    _Len = 0;
+}
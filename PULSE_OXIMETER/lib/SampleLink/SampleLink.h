@@ -0,0 +1,36 @@
+#ifndef SAMPLELINK_H
+#define SAMPLELINK_H
+
+#include <Arduino.h>
+
+#define LINK_SYNC0 0xA5                 //first sync byte of a frame
+#define LINK_SYNC1 0x5A                 //second sync byte
+#define LINK_SAMPLES 'S'                //frame type of a sample frame
+#define LINK_RESULT 'R'                 //frame type of a result frame
+#define LINK_FRAME_SAMPLES 8            //samples per sample frame
+#define LINK_ESCAPE 0x80                //delta byte announcing an absolute value instead
+#define LINK_MAX_PAYLOAD (1 + 6 + (LINK_FRAME_SAMPLES - 1) * 8)    //count, first sample, the rest escaped at worst
+
+/* |
+* @brief binary sample stream - red/IR samples and HR/SpO2 results in small framed packets instead of text lines,
+*        3.5 to 5 bytes per sample against about 60 for the text, so the serial link keeps up with far higher
+*        sample rates at the same baud rate. Sends on Serial, which must be started.
+*
+*        Frame: A5 5A type sequence length, then length payload bytes, then the CRC-CCITT (avr-libc
+*        _crc_ccitt_update, start FFFF) of type to the end of the payload, low byte first. The sequence number
+*        counts every frame, a gap tells the receiver frames were lost.
+*        'S' payload: sample count, the first red and IR as 3 bytes each (low byte first), then per further
+*        sample red and IR as a signed byte delta from the sample before - a delta out of -127..127 is the
+*        byte 80 followed by the 3 byte value. Every frame starts from an absolute sample, so a lost frame
+*        loses nothing after it.
+*        'R' payload: heart rate (int16), its valid flag, SpO2 (int16), its valid flag. Pending samples go out
+*        before a result, so the receiver applies each result from the next sample on, like the text lines.
+*        scripts/oximeter_decode.py turns a capture of either the binary or the text output into CSV.
+*/
+
+void link_begin();                                  //new stream: sequence from 0, no samples pending
+void link_sample(uint32_t red, uint32_t ir);        //adds a sample, a sample frame goes out every LINK_FRAME_SAMPLES of them
+void link_result(int32_t heartRate, int8_t hrValid, int32_t spo2, int8_t spo2Valid);   //sends the pending samples, then the result
+void link_flush();                                  //sends the pending samples now
+
+#endif
@@ -0,0 +1,109 @@
+#include "SensorFifo.h"
+#include <Wire.h>
+#include <avr/sleep.h>
+#include <avr/interrupt.h>
+
+#define FIFO_REG_STATUS1 0x00   //interrupt status 1, followed by status 2, enables, write pointer, overflow, read pointer
+#define FIFO_REG_DATA 0x07      //FIFO data, reading it moves the read pointer on
+
+static volatile bool _Pending;  //the INT pin fell since the last read
+static uint8_t _Left;           //entries the last read left in the FIFO
+static uint8_t _IntPin;
+static uint16_t _TimeoutMs;     //fifo_wait() reads the pointers anyway after this long
+static uint16_t _Lost;
+static uint32_t _Transactions;
+
+//the INT pin only has to flag the FIFO and wake the MCU up
+static void onInt(){_Pending = true;}
+
+//reads n registers from reg on in one I2C read, false when the sensor did not answer
+static bool readRegs(uint8_t reg, uint8_t *buf, uint8_t n){
+
+    _Transactions++;
+    Wire.beginTransmission(MAX30105_ADDRESS);
+    Wire.write(reg);
+    if(Wire.endTransmission(false) != 0){return false;}
+    if(Wire.requestFrom((uint8_t)MAX30105_ADDRESS, n) != n){return false;}
+    for(uint8_t i = 0; i < n; i++){buf[i] = Wire.read();}
+    return true;
+}
+
+//interrupt at almostFull entries (17-32) on intPin, FIFO emptied - fifo_wait() falls back to reading the pointers
+//every timeoutMs when the interrupt does not come
+void fifo_begin(MAX30105 &sensor, uint8_t intPin, uint8_t almostFull, uint16_t timeoutMs){
+
+    if(almostFull < FIFO_MIN_ALMOST_FULL){almostFull = FIFO_MIN_ALMOST_FULL;}
+    if(almostFull > FIFO_DEPTH){almostFull = FIFO_DEPTH;}
+
+    //the register holds the free slots left when the interrupt comes
+    sensor.setFIFOAlmostFull(FIFO_DEPTH - almostFull);
+    sensor.enableAFULL();
+    sensor.clearFIFO();
+    sensor.getINT1();
+
+    _Pending = false;
+    _Left = 0;
+    _Lost = 0;
+    _IntPin = intPin;
+    _TimeoutMs = timeoutMs;
+
+    //INT is open drain and active low
+    pinMode(intPin, INPUT_PULLUP);
+    attachInterrupt(digitalPinToInterrupt(intPin), onInt, FALLING);
+}
+
+//true while entries wait: the INT pin fell or is still low, or the last read left some behind - a pin that stays
+//low (its status was never read) does not fall again
+bool fifo_pending(){return _Pending || _Left || digitalRead(_IntPin) == LOW;}
+
+//idles the CPU until fifo_pending() or for timeoutMs at most - sleep_cpu right after sei runs before any interrupt, so
+//a fall after the check still wakes, and the millis() timer wakes it every millisecond to look at the time
+void fifo_wait(){
+
+    uint32_t since = millis();
+    set_sleep_mode(SLEEP_MODE_IDLE);
+    while(true){
+        cli();
+        if(fifo_pending() || millis() - since >= _TimeoutMs){sei(); return;}
+        sleep_enable();
+        sei();
+        sleep_cpu();
+        sleep_disable();
+    }
+}
+
+//reads up to max entries into the rings from index head on, returns how many
+uint8_t fifo_read(spo2_sample_t *red, spo2_sample_t *ir, uint16_t mask, uint16_t head, uint8_t max){
+
+    //cleared first, so a fall while reading is kept for the next time
+    _Pending = false;
+
+    //status (reading it releases the INT pin) and the pointers in one read
+    uint8_t regs[7];
+    if(!readRegs(FIFO_REG_STATUS1, regs, sizeof(regs))){_Pending = true; return 0;}   //INT may still be low, try again
+    uint8_t avail = (regs[4] - regs[6]) & (FIFO_DEPTH - 1);
+    if(regs[5]){_Lost += regs[5]; avail = FIFO_DEPTH;}    //overflowed, the pointers are equal and the FIFO is full
+
+    uint8_t n = avail < max ? avail : max;
+    uint8_t done = 0;
+    while(done < n){
+        uint8_t chunk = n - done < FIFO_CHUNK ? n - done : FIFO_CHUNK;
+        uint8_t buf[FIFO_CHUNK * FIFO_ENTRY];
+        if(!readRegs(FIFO_REG_DATA, buf, chunk * FIFO_ENTRY)){break;}
+
+        for(uint8_t i = 0; i < chunk; i++, done++){
+            const uint8_t *e = &buf[i * FIFO_ENTRY];
+            uint16_t k = (head + done) & mask;
+            red[k] = (((uint32_t)e[0] << 16) | ((uint32_t)e[1] << 8) | e[2]) & 0x3FFFF;
+            ir[k] = (((uint32_t)e[3] << 16) | ((uint32_t)e[4] << 8) | e[5]) & 0x3FFFF;
+        }
+    }
+    _Left = avail - done;
+    return done;
+}
+
+//entries the sensor overwrote before they were read
+uint16_t fifo_lost(){return _Lost;}
+
+//I2C reads done so far
+uint32_t fifo_transactions(){return _Transactions;}
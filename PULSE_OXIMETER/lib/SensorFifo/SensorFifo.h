@@ -0,0 +1,35 @@
+#ifndef SENSORFIFO_H
+#define SENSORFIFO_H
+
+#include <Arduino.h>
+#include <MAX30105.h>
+#include <Spo2.h>
+
+#define FIFO_DEPTH 32           //entries the sensor FIFO holds
+#define FIFO_MIN_ALMOST_FULL 17 //fewest entries the almost full interrupt can be set to
+#define FIFO_ENTRY 6            //bytes per entry in red + IR mode, red then IR, 3 bytes each MSB first
+#define FIFO_CHUNK 5            //entries per I2C read, the Wire buffer takes 32 bytes
+
+/* |
+* @brief interrupt driven FIFO reads for the MAX30102 in red + IR mode - instead of polling the read and write
+*        pointers for every sample, the sensor pulls its INT pin low once its FIFO is almost full and
+*        fifo_read() then takes all entries waiting (up to 32) in a burst: one read of the status and pointer
+*        registers (which also releases the INT pin), then the FIFO data in reads of FIFO_CHUNK entries,
+*        straight into the red and IR rings. Between bursts fifo_wait() keeps the CPU idle, the INT pin
+*        interrupt only sets a flag since Wire cannot be used from it. The samples keep the sensor's own
+*        sample clock, nothing is dropped as long as the FIFO is read before it overflows - the overflow
+*        counter of the sensor is added up for fifo_lost().
+*        A missed interrupt does not stall the reads: a failed status read is tried again, INT still low counts as
+*        pending, and without INT (not wired) fifo_wait() gives up after the timeout and the pointers are read
+*        as when polling - the timeout must be shorter than the sensor takes to fill its FIFO.
+*        The sensor must have been set up (MAX30105::setup()) in red + IR mode first.
+*/
+
+void fifo_begin(MAX30105 &sensor, uint8_t intPin, uint8_t almostFull, uint16_t timeoutMs);    //interrupt at almostFull entries (17-32) on intPin, FIFO emptied
+bool fifo_pending();                        //true while entries wait: the INT pin fell or is low, or the last read left some behind
+void fifo_wait();                           //idles the CPU until fifo_pending() or for timeoutMs at most
+uint8_t fifo_read(spo2_sample_t *red, spo2_sample_t *ir, uint16_t mask, uint16_t head, uint8_t max);  //reads up to max entries into the rings from index head on, returns how many
+uint16_t fifo_lost();                       //entries the sensor overwrote before they were read
+uint32_t fifo_transactions();               //I2C reads done so far
+
+#endif
@@ -0,0 +1,467 @@
+/*
+* The valley search and the ratio calculation follow the Maxim reference algorithm for the MAX30102
+* (MAXREFDES117#, algorithm.cpp), which carries this notice:
+*
+* Copyright (C) 2016 Maxim Integrated Products, Inc., All Rights Reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+* IN NO EVENT SHALL MAXIM INTEGRATED BE LIABLE FOR ANY CLAIM, DAMAGES
+* OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*
+* Except as contained in this notice, the name of Maxim Integrated
+* Products, Inc. shall not be used except as stated in the Maxim Integrated
+* Products, Inc. Branding Policy.
+*
+* The mere transfer of this software does not imply any licenses
+* of trade secrets, proprietary technology, copyrights, patents,
+* trademarks, maskwork rights, or any other form of intellectual
+* property whatsoever. Maxim Integrated Products, Inc. retains all
+* ownership rights.
+*/
+#include "Spo2.h"
+
+#define SPO2_RECIP 128          //reciprocal table entries, valley intervals and beats must be shorter
+
+//SpO2 by AC/DC ratio x100, the reference fit -45.060 * r^2 + 30.354 * r + 94.845 rounded and clamped to 0-100
+static const uint8_t spo2Table[184] PROGMEM = {
+    95, 95, 95, 96, 96, 96, 97, 97, 97, 97, 97, 98, 98, 98, 98, 98, 99, 99, 99, 99,
+    99, 99, 99, 99, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100,
+    100, 100, 100, 100, 99, 99, 99, 99, 99, 99, 99, 99, 98, 98, 98, 98, 98, 98, 97, 97,
+    97, 97, 96, 96, 96, 96, 95, 95, 95, 94, 94, 94, 93, 93, 93, 92, 92, 92, 91, 91,
+    90, 90, 89, 89, 89, 88, 88, 87, 87, 86, 86, 85, 85, 84, 84, 83, 82, 82, 81, 81,
+    80, 80, 79, 78, 78, 77, 76, 76, 75, 74, 74, 73, 72, 72, 71, 70, 69, 69, 68, 67,
+    66, 66, 65, 64, 63, 62, 62, 61, 60, 59, 58, 57, 56, 56, 55, 54, 53, 52, 51, 50,
+    49, 48, 47, 46, 45, 44, 43, 42, 41, 40, 39, 38, 37, 36, 35, 34, 33, 31, 30, 29,
+    28, 27, 26, 25, 23, 22, 21, 20, 19, 17, 16, 15, 14, 12, 11, 10, 9, 7, 6, 5,
+    3, 2, 1, 0
+};
+
+//65536 / d rounded up, the AVR has no divider - a quotient of up to 16 bits by d is exact with it
+static const uint16_t spo2Recip[SPO2_RECIP] PROGMEM = {
+    0, 0, 32768, 21846, 16384, 13108, 10923, 9363, 8192, 7282, 6554, 5958, 5462, 5042, 4682, 4370,
+    4096, 3856, 3641, 3450, 3277, 3121, 2979, 2850, 2731, 2622, 2521, 2428, 2341, 2260, 2185, 2115,
+    2048, 1986, 1928, 1873, 1821, 1772, 1725, 1681, 1639, 1599, 1561, 1525, 1490, 1457, 1425, 1395,
+    1366, 1338, 1311, 1286, 1261, 1237, 1214, 1192, 1171, 1150, 1130, 1111, 1093, 1075, 1058, 1041,
+    1024, 1009, 993, 979, 964, 950, 937, 924, 911, 898, 886, 874, 863, 852, 841, 830,
+    820, 810, 800, 790, 781, 772, 763, 754, 745, 737, 729, 721, 713, 705, 698, 690,
+    683, 676, 669, 662, 656, 649, 643, 637, 631, 625, 619, 613, 607, 602, 596, 591,
+    586, 580, 575, 570, 565, 561, 556, 551, 547, 542, 538, 533, 529, 525, 521, 517
+};
+
+//x / d truncated like the C division, for 1 <= d < SPO2_RECIP: two 16 x 16 bit multiplies instead of a 32 bit
+//division, exact for |x| < 65536 / d, otherwise off by less than |x| / 65536
+static int32_t divRecip(int32_t x, uint8_t d){
+
+    if(d == 1){return x;}
+    uint16_t r = pgm_read_word(&spo2Recip[d]);
+    uint32_t u = x < 0 ? -(uint32_t)x : x;
+    uint32_t q = (u >> 16) * r + (((u & 0xFFFF) * r) >> 16);
+    return x < 0 ? -(int32_t)q : (int32_t)q;
+}
+
+//the quotient is below SPO2_RATIO_CAP as far as the table goes, so 10 shift and subtract steps replace the 32 bit
+//division - rem is shifted down rather than denom up, denom << bit would drop bits from denom >= 2^(32 - bit) on
+int32_t spo2_ratio(int32_t nume, uint32_t denom){
+
+    uint32_t rem = (nume < 0 ? -(uint32_t)nume : nume) * 100;
+    int32_t q = 0;
+    if((rem >> 10) >= denom){q = SPO2_RATIO_CAP - 1;}
+    else{
+        for(int8_t bit = 9; bit >= 0; bit--){
+            if((rem >> bit) >= denom){rem -= denom << bit; q |= 1 << bit;}
+        }
+    }
+    return nume < 0 ? -q : q;
+}
+
+//sample k of the window
+static inline int32_t irAt(const Spo2Window *w, uint16_t k){return w->ir[(w->start + k) & w->mask];}
+static inline int32_t redAt(const Spo2Window *w, uint16_t k){return w->red[(w->start + k) & w->mask];}
+
+//IR less its mean and inverted, so the valleys are peaks, averaged with the next 3 samples - the last SPO2_MA4
+//samples of the window are not averaged, as in the reference
+static int32_t smoothed(const Spo2Window *w, int32_t mean, uint16_t k){
+
+    if(k + SPO2_MA4 >= w->len){return mean - irAt(w, k);}
+    return (4 * mean - (irAt(w, k) + irAt(w, k + 1) + irAt(w, k + 2) + irAt(w, k + 3))) / 4;
+}
+
+static void sortAscend(int32_t *x, uint8_t n){
+
+    for(uint8_t i = 1; i < n; i++){
+        int32_t t = x[i];
+        uint8_t j;
+        for(j = i; j > 0 && t < x[j - 1]; j--){x[j] = x[j - 1];}
+        x[j] = t;
+    }
+}
+
+static void sortLocsAscend(uint16_t *locs, uint8_t n){
+
+    for(uint8_t i = 1; i < n; i++){
+        uint16_t t = locs[i];
+        uint8_t j;
+        for(j = i; j > 0 && t < locs[j - 1]; j--){locs[j] = locs[j - 1];}
+        locs[j] = t;
+    }
+}
+
+//heart rate of valleys cnt apart over span samples, from the mean interval truncated as in the reference
+static void heartRateOf(uint16_t span, uint8_t cnt, int32_t *heartRate, int8_t *hrValid){
+
+    int32_t interval = cnt ? divRecip(span, cnt) : 0;
+    if(interval > 0 && interval < SPO2_RECIP){
+        *heartRate = divRecip(SPO2_FS * 60, interval);
+        *hrValid = 1;
+    }
+    else{
+        *heartRate = SPO2_INVALID;
+        *hrValid = 0;
+    }
+}
+
+//AC/DC ratio x100 of red (y) and IR (x) between the valleys at ring positions p0 and p1, on the raw samples -
+//false when the valleys are too close or the ratio is no use
+static bool segmentRatio(const spo2_sample_t *ir, const spo2_sample_t *red, uint16_t mask, uint16_t p0, uint16_t p1, int32_t *ratio){
+
+    uint16_t len = p1 - p0;
+    if(len <= 3 || len >= SPO2_RECIP){return false;}
+
+    //maximum of both between the valleys, as offsets from p0
+    int32_t xDcMax = -16777216, yDcMax = -16777216;
+    uint16_t xDcMaxIdx = 0, yDcMaxIdx = 0;
+    for(uint16_t i = 0; i < len; i++){
+        int32_t x = ir[(p0 + i) & mask], y = red[(p0 + i) & mask];
+        if(x > xDcMax){xDcMax = x; xDcMaxIdx = i;}
+        if(y > yDcMax){yDcMax = y; yDcMaxIdx = i;}
+    }
+
+    //AC: the maximum less the line between the valleys there (the reference takes the IR at the red maximum)
+    int32_t x0 = ir[p0 & mask], x1 = ir[p1 & mask];
+    int32_t y0 = red[p0 & mask], y1 = red[p1 & mask];
+    int32_t yAc = red[(p0 + yDcMaxIdx) & mask] - (y0 + divRecip((y1 - y0) * (int32_t)yDcMaxIdx, len));
+    int32_t xAc = ir[(p0 + yDcMaxIdx) & mask] - (x0 + divRecip((x1 - x0) * (int32_t)xDcMaxIdx, len));
+
+    //x100 keeps two decimals of the ratio
+    int32_t nume = (yAc * xDcMax) >> 7;
+    int32_t denom = (xAc * yDcMax) >> 7;
+    if(denom <= 0 || nume == 0){return false;}
+    *ratio = spo2_ratio(nume, denom);
+    return true;
+}
+
+//SpO2 of the median ratio, the signal varies from beat to beat - sorts the ratios
+static void spo2OfRatios(int32_t *ratios, uint8_t cnt, int32_t *spo2, int8_t *spo2Valid){
+
+    sortAscend(ratios, cnt);
+    uint8_t mid = cnt / 2;
+    int32_t ratio = 0;
+    if(mid > 1){ratio = (ratios[mid - 1] + ratios[mid]) / 2;}
+    else if(cnt){ratio = ratios[mid];}
+
+    if(ratio > 2 && ratio < 184){
+        *spo2 = pgm_read_byte(&spo2Table[ratio]);
+        *spo2Valid = 1;
+    }
+    else{
+        *spo2 = SPO2_INVALID;
+        *spo2Valid = 0;
+    }
+}
+
+//sorts the locations by their heights, highest first - the heights are sorted along
+static void sortLocsByHeight(uint16_t *locs, int32_t *heights, uint8_t n){
+
+    for(uint8_t i = 1; i < n; i++){
+        uint16_t t = locs[i];
+        int32_t h = heights[i];
+        uint8_t j;
+        for(j = i; j > 0 && h > heights[j - 1]; j--){locs[j] = locs[j - 1]; heights[j] = heights[j - 1];}
+        locs[j] = t;
+        heights[j] = h;
+    }
+}
+
+//peaks of the smoothed signal above minHeight, a flat peak is at its left edge - returns the number found
+static uint8_t peaksAboveMinHeight(const Spo2Window *w, int32_t mean, uint16_t *locs, int32_t minHeight){
+
+    uint8_t n = 0;
+    uint16_t i = 1;
+    while(i < w->len - 1){
+
+        //left edge of a possible peak
+        int32_t x = smoothed(w, mean, i);
+        if(x <= minHeight || x <= smoothed(w, mean, i - 1)){i++; continue;}
+
+        //find the right edge of a flat peak, a peak running into the end of the window is none
+        uint16_t width = 1;
+        int32_t right = x;
+        while(i + width < w->len && x == (right = smoothed(w, mean, i + width))){width++;}
+        if(x > right && n < SPO2_MAX_PEAKS){
+            locs[n++] = i;
+            i += width + 1;
+        }
+        else{i += width;}
+    }
+    return n;
+}
+
+//keeps the highest of peaks closer than minDistance to each other (heights[] is reordered), returns the peaks left
+//in ascending order
+static uint8_t removeClosePeaks(uint16_t *locs, int32_t *heights, uint8_t n, int16_t minDistance){
+
+    sortLocsByHeight(locs, heights, n);
+
+    //the lag zero peak of the reference autocorrelation sits at -1
+    for(int8_t i = -1; i < (int8_t)n; i++){
+        uint8_t old = n;
+        n = i + 1;
+        for(uint8_t j = i + 1; j < old; j++){
+            int16_t dist = (int16_t)locs[j] - (i == -1 ? -1 : (int16_t)locs[i]);
+            if(dist > minDistance || dist < -minDistance){locs[n++] = locs[j];}
+        }
+    }
+
+    sortLocsAscend(locs, n);
+    return n;
+}
+
+//heart rate (bpm) and SpO2 (%) of the window, each with a flag telling whether it could be calculated
+void spo2_calc(const Spo2Window *w, int32_t *spo2, int8_t *spo2Valid, int32_t *heartRate, int8_t *hrValid){
+
+    uint16_t valleys[SPO2_MAX_PEAKS];
+
+    //DC mean of the IR
+    uint32_t sum = 0;
+    for(uint16_t k = 0; k < w->len; k++){sum += irAt(w, k);}
+    int32_t mean = sum / w->len;
+
+    //threshold: the mean of the smoothed signal, within 30 and 60
+    int32_t th = 0;
+    for(uint16_t k = 0; k < w->len; k++){th += smoothed(w, mean, k);}
+    th = th / (int32_t)w->len;
+    if(th < 30){th = 30;}
+    if(th > 60){th = 60;}
+
+    //the IR was inverted, so its valleys are the peaks
+    uint8_t npks = peaksAboveMinHeight(w, mean, valleys, th);
+    int32_t heights[SPO2_MAX_PEAKS];
+    for(uint8_t k = 0; k < npks; k++){heights[k] = smoothed(w, mean, valleys[k]);}
+    npks = removeClosePeaks(valleys, heights, npks, SPO2_MIN_DISTANCE);
+
+    //the intervals add up to the span from the first valley to the last
+    heartRateOf(npks ? valleys[npks - 1] - valleys[0] : 0, npks ? npks - 1 : 0, heartRate, hrValid);
+
+    //ratio of the AC/DC of red and IR between each two valleys, the first 5 that have one
+    int32_t ratios[5];
+    uint8_t ratioCnt = 0;
+    for(uint8_t k = 0; k + 1 < npks && ratioCnt < 5; k++){
+        if(segmentRatio(w->ir, w->red, w->mask, w->start + valleys[k], w->start + valleys[k + 1], &ratios[ratioCnt])){ratioCnt++;}
+    }
+    spo2OfRatios(ratios, ratioCnt, spo2, spo2Valid);
+}
+
+//a valley found by the stream - every local minimum of the level is kept, whether it counts is only decided when
+//reading, against the mean and the threshold of the window then
+struct Spo2Valley{
+    uint16_t loc;               //sample count it is at
+    int32_t level;              //level there, the lower the deeper the valley
+    bool hasRatio;              //the beat from the valley kept before ends here with a ratio
+    int32_t ratio;              //AC/DC ratio x100 of that beat
+};
+
+//state of the valley search, copied when reading to run it over the end of the window
+struct Spo2Search{
+    int32_t prev;               //level of the sample before
+    bool cand;                  //a possible valley is being followed
+    uint16_t candLoc;           //its left edge
+    int32_t candLevel;          //its level
+};
+
+static const spo2_sample_t *_Ir, *_Red;     //rings
+static uint16_t _Mask;
+static uint16_t _Len;                       //window length
+static uint16_t _Kept;                      //samples back from the next one to push that no write ahead can have reached
+static uint16_t _N;                         //samples pushed, wraps - sample n is at ring index n & _Mask
+static uint16_t _Filled;                    //samples in the window so far
+static uint32_t _IrSum;                     //IR sum over the window
+static uint32_t _LevelSum;                  //level sum over the window but its last SPO2_MA4 samples
+static Spo2Search _Search;                  //valley search up to the last SPO2_MA4 samples
+static Spo2Valley _Valleys[SPO2_VALLEYS];   //the last valleys found, oldest first
+static uint8_t _VHead;                      //index of the next valley
+static uint8_t _VCnt;                       //valleys kept
+
+static inline int32_t sum4At(uint16_t m){
+    return (int32_t)_Ir[m & _Mask] + _Ir[(m + 1) & _Mask] + _Ir[(m + 2) & _Mask] + _Ir[(m + 3) & _Mask];
+}
+
+//level at m: the 4 sample IR sum / 4 rounded up. Where smoothed() is positive it is the mean less the level (the
+//division by 4 truncates), so the valleys that can count are found on the level with the same ties and without the
+//mean. The last SPO2_MA4 samples of the window are not averaged, their level is the sample itself
+static inline int32_t levelAt(uint16_t m){return (sum4At(m) + 3) >> 2;}
+
+//moves the valley search on to the sample at m of the given level: a drop starts a possible valley, a flat bottom
+//keeps its left edge, the first rise after it confirms it - true when it does, the valley is in candLoc/candLevel
+static bool step(Spo2Search *s, uint16_t m, int32_t level){
+
+    bool found = false;
+    if(s->cand){
+        if(level > s->candLevel){found = true; s->cand = false;}
+        else if(level < s->candLevel){s->cand = false;}
+    }
+    if(!s->cand && level < s->prev){
+        s->cand = true;
+        s->candLoc = m;
+        s->candLevel = level;
+    }
+    s->prev = level;
+    return found;
+}
+
+//adds the valley at loc after the last one kept
+static void addValley(uint16_t loc, int32_t level){
+
+    Spo2Valley *last = _VCnt ? &_Valleys[(_VHead - 1) & (SPO2_VALLEYS - 1)] : nullptr;
+    Spo2Valley *v = &_Valleys[_VHead];
+    v->loc = loc;
+    v->level = level;
+
+    //the ratio of the beat is worked out now, while the samples since the last valley are still in the ring -
+    //a beat longer than the window never has one in spo2_calc() either
+    v->hasRatio = last && (uint16_t)(_N - last->loc) <= _Kept && (uint16_t)(loc - last->loc) < _Len
+                  && segmentRatio(_Ir, _Red, _Mask, last->loc, loc, &v->ratio);
+
+    _VHead = (_VHead + 1) & (SPO2_VALLEYS - 1);
+    if(_VCnt < SPO2_VALLEYS){_VCnt++;}
+}
+
+//ratio of the beat between the valleys at from and to: the one worked out when to was found if from was the valley
+//before it, otherwise from the ring - a valley between them did not count in this window
+static bool beatRatio(uint16_t from, uint16_t to, int32_t *ratio){
+
+    for(uint8_t k = 1; k < _VCnt; k++){
+        const Spo2Valley *v = &_Valleys[(_VHead - k) & (SPO2_VALLEYS - 1)];
+        if(v->loc != to){continue;}
+        if(_Valleys[(_VHead - k - 1) & (SPO2_VALLEYS - 1)].loc != from){break;}
+        *ratio = v->ratio;
+        return v->hasRatio;
+    }
+    return segmentRatio(_Ir, _Red, _Mask, from, to, ratio);
+}
+
+//adds the valley at window position at with the height h as a peak, as spo2_calc() finds them
+static void addPeak(uint16_t *locs, int32_t *heights, uint8_t *n, uint16_t at, int32_t h, int32_t th){
+
+    if(at >= 1 && at < _Len && h > th && *n < SPO2_MAX_PEAKS){
+        locs[*n] = at;
+        heights[(*n)++] = h;
+    }
+}
+
+//starts the stream over the rings with a window of len samples, the caller writes up to ahead samples past the last one pushed
+void spo2_begin(const spo2_sample_t *ir, const spo2_sample_t *red, uint16_t mask, uint16_t len, uint16_t ahead){
+
+    _Ir = ir;
+    _Red = red;
+    _Mask = mask;
+    _Len = len;
+    _Kept = mask + 1 - ahead;
+    _N = 0;
+    _Filled = 0;
+    _IrSum = 0;
+    _LevelSum = 0;
+    _Search.cand = false;
+    _VHead = 0;
+    _VCnt = 0;
+}
+
+//takes in the sample just written to the rings: running sums and valley search move on one sample, all of it in adds
+//and compares
+void spo2_push(){
+
+    uint16_t n = _N++;
+    _IrSum += _Ir[n & _Mask];
+    if(_Filled < _Len){_Filled++;}
+    else{
+        _IrSum -= _Ir[(n - _Len) & _Mask];
+        _LevelSum -= levelAt(n - _Len);
+    }
+    if(_Filled <= SPO2_MA4){return;}
+
+    //the 4 point average of the sample SPO2_MA4 back is complete now and no longer at the end of the window, where
+    //spo2_calc() does not average
+    uint16_t m = n - SPO2_MA4;
+    int32_t level = levelAt(m);
+    _LevelSum += level;
+    if(_Filled == SPO2_MA4 + 1){
+        _Search.prev = level;
+        return;
+    }
+    if(step(&_Search, m, level)){addValley(_Search.candLoc, _Search.candLevel);}
+}
+
+//heart rate (bpm) and SpO2 (%) of the valleys inside the window
+void spo2_read(int32_t *spo2, int8_t *spo2Valid, int32_t *heartRate, int8_t *hrValid){
+
+    uint16_t locs[SPO2_MAX_PEAKS];
+    int32_t heights[SPO2_MAX_PEAKS];
+    uint8_t npks = 0;
+    uint16_t start = _N - _Len;
+    if(_Filled == _Len){
+
+        //DC mean of the IR, the smoothed signal is the mean less the level - reading divides for it and the threshold,
+        //pushing never does
+        int32_t mean = _IrSum / _Len;
+        uint16_t tail = _N - SPO2_MA4;
+
+        //threshold: the mean of the smoothed signal, within 30 and 60. Where smoothed() is negative it truncates up,
+        //the level sum comes up to 1 per sample short there - when that can move the threshold between the limits
+        //the window is summed over as spo2_calc() does
+        int32_t sum = (int32_t)_Len * mean - (int32_t)_LevelSum - sum4At(tail);
+        if(sum > 29 * (int32_t)_Len && sum < 60 * (int32_t)_Len){
+            sum = SPO2_MA4 * mean - sum4At(tail);
+            for(uint16_t m = start; m != tail; m++){sum += (4 * mean - sum4At(m)) / 4;}
+        }
+        int32_t th = sum / (int32_t)_Len;
+        if(th < 30){th = 30;}
+        if(th > 60){th = 60;}
+
+        //the valleys kept inside the window that are high enough, then the ones the search finds on to the end of it
+        uint8_t i = (_VHead - _VCnt) & (SPO2_VALLEYS - 1);
+        for(uint8_t left = _VCnt; left; left--, i = (i + 1) & (SPO2_VALLEYS - 1)){
+            addPeak(locs, heights, &npks, _Valleys[i].loc - start, mean - _Valleys[i].level, th);
+        }
+        Spo2Search s = _Search;
+        for(uint16_t m = tail; m != _N; m++){
+            if(step(&s, m, _Ir[m & _Mask])){
+                addPeak(locs, heights, &npks, s.candLoc - start, mean - s.candLevel, th);
+            }
+        }
+        npks = removeClosePeaks(locs, heights, npks, SPO2_MIN_DISTANCE);
+    }
+
+    //the intervals add up to the span from the first valley to the last
+    heartRateOf(npks ? locs[npks - 1] - locs[0] : 0, npks ? npks - 1 : 0, heartRate, hrValid);
+
+    //ratio of the AC/DC of red and IR between each two valleys, the first 5 that have one
+    int32_t ratios[5];
+    uint8_t ratioCnt = 0;
+    for(uint8_t k = 0; k + 1 < npks && ratioCnt < 5; k++){
+        if(beatRatio(start + locs[k], start + locs[k + 1], &ratios[ratioCnt])){ratioCnt++;}
+    }
+    spo2OfRatios(ratios, ratioCnt, spo2, spo2Valid);
+}
@@ -0,0 +1,67 @@
+#ifndef SPO2_H
+#define SPO2_H
+
+#include <Arduino.h>
+
+#define SPO2_FS 25              //samples per second in the window
+#define SPO2_MA4 4              //samples of the moving average the valleys are found on
+#define SPO2_MAX_PEAKS 15       //most valleys used per window
+#define SPO2_MIN_DISTANCE 4     //valleys closer than this (in samples) count as one
+#define SPO2_INVALID -999       //heart rate or SpO2 when it could not be calculated
+#define SPO2_VALLEYS 16         //valleys the stream keeps, a power of 2 above SPO2_MAX_PEAKS
+#define SPO2_RATIO_CAP 1024     //beat ratios x100 from here up come out as SPO2_RATIO_CAP - 1, far off the table anyway
+
+/* |
+* @brief heart rate and SpO2 from a window of red and IR samples - the Maxim reference algorithm
+*        (DC removal, inversion, 4 point moving average, valley search, AC/DC ratio of red and IR between valleys,
+*        ratio to SpO2 table) with the same results, reading the samples straight out of a circular buffer.
+*        The window may wrap around the end of the ring, nothing is copied: the smoothed signal is computed from
+*        the ring where it is needed instead of into work arrays, so no RAM is needed beyond the ring itself.
+*        spo2_begin()/spo2_push()/spo2_read() do the same as a stream: every new sample updates the running
+*        DC sums and moves the valley search on by one sample. The search keeps every valley of the 4 point sums
+*        (rounded up to a quarter, the mean is not needed to find them) and works out the ratio of a beat when
+*        its closing valley is found. Reading takes the mean and threshold of the window as it is then, keeps the
+*        valleys inside it that are high enough, runs the search over its last SPO2_MA4 samples unaveraged and
+*        drops close valleys as spo2_calc() does - the results are the same as spo2_calc() on the same window.
+*        Only a window with more than SPO2_VALLEYS valleys (noise rather than beats) may come out different,
+*        reading only sees the last ones. Reading costs a few dozen compares and two divisions and may be done
+*        at any rate - a beat's ratio is only worked out again when a valley inside it does not count, and the
+*        window is only summed over again when its threshold comes out between the limits.
+*        The AVR has no divider, so pushing and the beat math do without 32 bit divisions: the line under a
+*        beat and the beat interval to bpm multiply with a table of reciprocals, and the ratio x100 is found by
+*        10 shift and subtract steps as it only matters below 10.24. Against the reference the heart rate and the
+*        ratio are exact, the AC of a beat is off by at most 1 + |red or IR step between its valleys| * length / 65536
+*        counts (1 count for steps under 650 counts over a 100 sample beat).
+*/
+
+#if defined(__AVR_ATmega328P__) || defined(__AVR_ATmega168__)
+typedef uint16_t spo2_sample_t;         //the AVR keeps the low 16 bits of the 18 bit samples, as the reference does
+#else
+typedef uint32_t spo2_sample_t;
+#endif
+
+//a window of samples in the red and IR rings
+struct Spo2Window{
+    const spo2_sample_t *ir;    //IR ring
+    const spo2_sample_t *red;   //red ring, the same size
+    uint16_t mask;              //ring size - 1, the ring size must be a power of 2
+    uint16_t start;             //ring index of the oldest sample of the window
+    uint16_t len;               //samples in the window, at most the ring size
+};
+
+//heart rate (bpm) and SpO2 (%) of the window, each with a flag telling whether it could be calculated
+void spo2_calc(const Spo2Window *w, int32_t *spo2, int8_t *spo2Valid, int32_t *heartRate, int8_t *hrValid);
+//ratio x100 of a beat, 100 * nume / denom truncated for denom > 0 and 100 * |nume| < 2^31 - from SPO2_RATIO_CAP up
+//it comes out as SPO2_RATIO_CAP - 1
+int32_t spo2_ratio(int32_t nume, uint32_t denom);
+
+//starts the stream over the rings (mask = ring size - 1, a power of 2) with a window of len samples - the caller writes
+//the n-th sample after this at ring index n & mask, and at most ahead samples past the last one pushed (a sensor burst),
+//len + SPO2_MA4 + ahead must fit the ring. A beat is only measured while none of its samples can have been overwritten
+void spo2_begin(const spo2_sample_t *ir, const spo2_sample_t *red, uint16_t mask, uint16_t len, uint16_t ahead);
+//takes in the sample just written to the rings
+void spo2_push();
+//heart rate (bpm) and SpO2 (%) of the last len samples pushed, like spo2_calc()
+void spo2_read(int32_t *spo2, int8_t *spo2Valid, int32_t *heartRate, int8_t *hrValid);
+
+#endif
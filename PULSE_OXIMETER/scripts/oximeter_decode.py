@@ -0,0 +1,141 @@
+# Oximeter output decoder: turns a capture of the serial output into CSV, one row per sample, the same for the
+# binary output (start key b, SampleLink frames) and the text output (any other start key).
+# capture the output and decode it with either of:
+#   python scripts/oximeter_decode.py capture.bin > samples.csv
+#   python scripts/oximeter_decode.py --port /dev/ttyUSB0 > samples.csv      (needs pyserial, stop with Ctrl+C)
+# samples sent before the first result have empty result columns, as their text lines carry none.
+import argparse
+import re
+import sys
+
+SYNC = b"\xa5\x5a"
+ESCAPE = 0x80
+HEADER = "red,ir,hr,hr_valid,spo2,spo2_valid"
+TEXT_LINE = re.compile(
+    rb"red=(-?\d+), ir=(-?\d+)(?:, HR=(-?\d+), HRvalid=(-?\d+), SPO2=(-?\d+), SPO2Valid=(-?\d+))?\r?$")
+
+
+def crc_ccitt(data, crc=0xFFFF):
+    """CRC of avr-libc _crc_ccitt_update"""
+    for b in data:
+        crc ^= b
+        for _ in range(8):
+            crc = (crc >> 1) ^ 0x8408 if crc & 1 else crc >> 1
+    return crc
+
+
+def u24(data, i):
+    return data[i] | (data[i + 1] << 8) | (data[i + 2] << 16)
+
+
+def s16(data, i):
+    v = data[i] | (data[i + 1] << 8)
+    return v - 0x10000 if v & 0x8000 else v
+
+
+def frames(data):
+    """yields (type, sequence, payload) of every frame with a good CRC, the bytes between frames are skipped"""
+    start = data.find(SYNC)
+    while start >= 0:
+        if start + 5 <= len(data):
+            length = data[start + 4]
+            end = start + 5 + length + 2
+            if end <= len(data):
+                body = data[start + 2:start + 5 + length]
+                if crc_ccitt(body) == data[end - 2] | (data[end - 1] << 8):
+                    yield body[0], body[1], body[3:]
+                    start = data.find(SYNC, end)
+                    continue
+        start = data.find(SYNC, start + 1)
+
+
+def samples(payload):
+    """red and IR of every sample of a sample frame"""
+    count = payload[0]
+    red, ir = u24(payload, 1), u24(payload, 4)
+    out = [(red, ir)]
+    i = 7
+    for _ in range(count - 1):
+        v = []
+        for prev in (red, ir):
+            d = payload[i]
+            if d == ESCAPE:
+                v.append(u24(payload, i + 1))
+                i += 4
+            else:
+                v.append(prev + (d - 256 if d & 0x80 else d))
+                i += 1
+        red, ir = v
+        out.append((red, ir))
+    return out
+
+
+def binary_rows(data):
+    """rows of the frames in the capture, None when it holds no frame"""
+    rows = []
+    result = None
+    seq = None
+    found = False
+    for kind, n, payload in frames(data):
+        found = True
+        if seq is not None and n != (seq + 1) & 0xFF:
+            sys.stderr.write("oximeter_decode: %d frames lost before frame %d\n" % ((n - seq - 1) & 0xFF, n))
+        seq = n
+        if kind == ord("S"):
+            rows += [(red, ir) + (result or ()) for red, ir in samples(payload)]
+        elif kind == ord("R"):
+            result = (s16(payload, 0), payload[2], s16(payload, 3), payload[5])
+    return rows if found else None
+
+
+def text_rows(data):
+    """rows of the text lines in the capture"""
+    rows = []
+    for line in data.split(b"\n"):
+        m = TEXT_LINE.search(line)
+        if m:
+            rows.append(tuple(int(g) for g in m.groups() if g is not None))
+    return rows
+
+
+def read_port(port):
+    import serial
+
+    data = b""
+    with serial.Serial(port, 115200, timeout=1) as ser:
+        try:
+            while True:
+                data += ser.read(256)
+        except KeyboardInterrupt:
+            return data
+
+
+def main():
+    parser = argparse.ArgumentParser(description="decode the PULSE_OXIMETER serial output into CSV")
+    parser.add_argument("capture", nargs="?", help="capture of the serial output, stdin when omitted")
+    parser.add_argument("--port", help="read the output straight from this serial port until Ctrl+C")
+    args = parser.parse_args()
+
+    if args.port:
+        data = read_port(args.port)
+    elif args.capture:
+        with open(args.capture, "rb") as f:
+            data = f.read()
+    else:
+        data = sys.stdin.buffer.read()
+
+    rows = binary_rows(data)
+    if rows is None:
+        rows = text_rows(data)
+    if not rows:
+        sys.stderr.write("oximeter_decode: no samples found\n")
+        return 1
+
+    print(HEADER)
+    for row in rows:
+        print(",".join(str(v) for v in row + ("",) * (6 - len(row))))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
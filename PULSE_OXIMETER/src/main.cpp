@@ -1,7 +1,9 @@
 
 #include <Wire.h>
 #include "MAX30105.h"
-#include "spo2_algorithm.h"
+#include <Spo2.h>
+#include <SampleLink.h>
+#include <SensorFifo.h>
 #include <Wire.h> 
 #include <LiquidCrystal_I2C.h>
 
@@ -11,27 +13,40 @@ MAX30105 particleSensor;
 
 #define MAX_BRIGHTNESS 255
 
-#if defined(__AVR_ATmega328P__) || defined(__AVR_ATmega168__)
+#define SAMPLE_RING 128 //samples kept of each LED, must be a power of 2
+#define WINDOW_LEN 100  //samples HR and SPO2 are calculated from, 4 seconds at 25sps
+#define UPDATE_LEN 25   //new samples between two calculations, 1 second at 25sps
+#define FIFO_INT_PIN 2  //MAX30102 INT pin, samples come in bursts when the FIFO is almost full - comment out to poll the sensor
+#define FIFO_BURST 17   //FIFO entries that pull INT low, 17-32
+#define FIFO_TIMEOUT 1000 //ms without INT before the FIFO is read anyway (INT not wired) - 17 entries take 680ms at 25sps, 32 overflow at 1280ms
+#define FIFO_AHEAD 24   //most samples a burst puts into the ring before they are taken
+static_assert((SAMPLE_RING & (SAMPLE_RING - 1)) == 0 && WINDOW_LEN + SPO2_MA4 + FIFO_AHEAD <= SAMPLE_RING, "the window and a burst must fit a power of 2 ring");
+static_assert(FIFO_BURST <= FIFO_AHEAD, "a burst must fit in one read");
+
+//the newest sample goes in at ringHead over the oldest one, the window is the last WINDOW_LEN samples - nothing is ever shifted,
+//the estimator takes in every sample as it comes and has HR and SPO2 of the window ready whenever they are read
+spo2_sample_t irRing[SAMPLE_RING]; //infrared LED sensor data
+spo2_sample_t redRing[SAMPLE_RING];  //red LED sensor data
+uint16_t ringHead; //ring index the next sample goes into
+uint8_t ringAhead; //samples a burst put in from ringHead on that were not taken yet
 
-uint16_t irBuffer[100]; //infrared LED sensor data
-uint16_t redBuffer[100];  //red LED sensor data
-#else
-uint32_t irBuffer[100]; //infrared LED sensor data
-uint32_t redBuffer[100];  //red LED sensor data
-#endif
-
-int32_t bufferLength; //data length
 int32_t spo2; //SPO2 value
 int8_t validSPO2; //indicator to show if the SPO2 calculation is valid
 int32_t heartRate; //heart rate value
 int8_t validHeartRate; //indicator to show if the heart rate calculation is valid
 
+bool binaryOut; //samples and results go out as SampleLink frames instead of text lines, chosen by the start key
+
 byte pulseLED = 11; //Must be on PWM pin
 byte readLED = 13; //Blinks with each data read
 
 const int LCD_COLS = 16;
 const int LCD_ROWS = 2;
 
+uint16_t readSample(); //waits for the next sample, puts it into the ring and into the estimator, returns its ring index
+void sendSample(uint16_t k, bool withResult); //sends the sample at ring index k, in text with the last result if asked
+void sendResult(); //sends a new result, the text lines carry it with every sample instead
+
 
 void setup()
 {
@@ -50,9 +65,10 @@ void setup()
     while (1);
   }
  
-  Serial.println(F("Attach sensor to finger with rubber band. Press any key to start conversion"));
+  Serial.println(F("Attach sensor to finger with rubber band. Press any key to start conversion, b for binary output"));
   while (Serial.available() == 0) ; //wait until user presses a key
-  Serial.read();
+  binaryOut = Serial.read() == 'b';
+  link_begin();
 
   byte ledBrightness = 60; //Options: 0=Off to 255=50mA
   byte sampleAverage = 4; //Options: 1, 2, 4, 8, 16, 32
@@ -62,77 +78,48 @@ void setup()
   int adcRange = 4096; //Options: 2048, 4096, 8192, 16384
 
   particleSensor.setup(ledBrightness, sampleAverage, ledMode, sampleRate, pulseWidth, adcRange); //Configure sensor with these settings
+#ifdef FIFO_INT_PIN
+  fifo_begin(particleSensor, FIFO_INT_PIN, FIFO_BURST, FIFO_TIMEOUT); //the INT pin now tells when to read
+#endif
+
+#ifdef FIFO_INT_PIN
+  spo2_begin(irRing, redRing, SAMPLE_RING - 1, WINDOW_LEN, FIFO_AHEAD); //the ring head starts at 0 with the estimator, a burst writes up to FIFO_AHEAD samples past it
+#else
+  spo2_begin(irRing, redRing, SAMPLE_RING - 1, WINDOW_LEN, 0); //the ring head starts at 0 with the estimator
+#endif
  
 }
 
 void loop()
 {
 
-  //buffer length of 100 stores 4 seconds of samples running at 25sps
-  bufferLength = 100;
-  
   lcd.setCursor(0,0);
   lcd.print(F("HR:"));
   lcd.setCursor(0,1);
   lcd.print(F("SPO2:"));
   
-  //read the first 100 samples, and determine the signal range
-  for ( byte i = 0 ; i < bufferLength ; i++)
+  //read the first WINDOW_LEN samples, and determine the signal range
+  for (byte i = 0 ; i < WINDOW_LEN ; i++)
   {
-    while (particleSensor.available() == false) //do we have new data?
-      particleSensor.check(); //Check the sensor for new data
-
-    redBuffer[i] = particleSensor.getRed();
-    irBuffer[i] = particleSensor.getIR();
-    particleSensor.nextSample(); //We're finished with this sample so move to next sample
-
-    Serial.print(F("red="));
-    Serial.print(redBuffer[i], DEC);
-    Serial.print(F(", ir="));
-    Serial.println(irBuffer[i], DEC);
+    uint16_t k = readSample();
+    sendSample(k, false);
   }
 
-  //calculate heart rate and SpO2 after first 100 samples (first 4 seconds of samples)
-  maxim_heart_rate_and_oxygen_saturation(irBuffer, bufferLength, redBuffer, &spo2, &validSPO2, &heartRate, &validHeartRate);
+  //heart rate and SpO2 after the first WINDOW_LEN samples (first 4 seconds of samples)
+  spo2_read(&spo2, &validSPO2, &heartRate, &validHeartRate);
+  sendResult();
   //Continuously taking samples from MAX30102.  Heart rate and SpO2 are calculated every 1 second
   while (1)
   {
-    //dumping the first 25 sets of samples in the memory and shift the last 75 sets of samples to the top
-    for (byte i = 25; i < 100; i++)
+    //take UPDATE_LEN sets of samples before calculating the heart rate, they take the place of the oldest ones
+    for (byte i = 0; i < UPDATE_LEN; i++)
     {
-      redBuffer[i - 25] = redBuffer[i];
-      irBuffer[i - 25] = irBuffer[i];
-    }
-
-    //take 25 sets of samples before calculating the heart rate.
-    for (byte i = 75; i < 100; i++)
-    {
-      while (particleSensor.available() == false) //do we have new data?
-        particleSensor.check(); //Check the sensor for new data
+      uint16_t k = readSample();
 
       digitalWrite(readLED, !digitalRead(readLED)); //Blink onboard LED with every data read
 
-      redBuffer[i] = particleSensor.getRed();
-      irBuffer[i] = particleSensor.getIR();
-      particleSensor.nextSample(); //We're finished with this sample so move to next sample
-
       //send samples and calculation result to terminal program through UART
-      Serial.print(F("red="));
-      Serial.print(redBuffer[i], DEC);
-      Serial.print(F(", ir="));
-      Serial.print(irBuffer[i], DEC);
-
-      Serial.print(F(", HR="));
-      Serial.print(heartRate, DEC);
-
-      Serial.print(F(", HRvalid="));
-      Serial.print(validHeartRate, DEC);
-
-      Serial.print(F(", SPO2="));
-      Serial.print(spo2, DEC);
-
-      Serial.print(F(", SPO2Valid="));
-      Serial.println(validSPO2, DEC);
+      sendSample(k, true);
     }
    
    
@@ -144,7 +131,70 @@ void loop()
       lcd.print(F("%"));
 
  
-    //After gathering 25 new samples recalculate HR and SP02
-    maxim_heart_rate_and_oxygen_saturation(irBuffer, bufferLength, redBuffer, &spo2, &validSPO2, &heartRate, &validHeartRate);
+    //After gathering UPDATE_LEN new samples read HR and SP02 again
+    spo2_read(&spo2, &validSPO2, &heartRate, &validHeartRate);
+    sendResult();
+  }
   }
-  }
\ No newline at end of file
+
+uint16_t readSample()
+{
+  uint16_t k = ringHead;
+#ifdef FIFO_INT_PIN
+  //a burst reads the whole FIFO into the ring ahead of the head, the CPU idles until the next one is due
+  while (ringAhead == 0)
+  {
+    fifo_wait();
+    ringAhead = fifo_read(redRing, irRing, SAMPLE_RING - 1, ringHead, FIFO_AHEAD);
+  }
+  ringAhead--;
+#else
+  while (particleSensor.available() == false) //do we have new data?
+    particleSensor.check(); //Check the sensor for new data
+
+  redRing[k] = particleSensor.getRed();
+  irRing[k] = particleSensor.getIR();
+  particleSensor.nextSample(); //We're finished with this sample so move to next sample
+#endif
+
+  ringHead = (k + 1) & (SAMPLE_RING - 1);
+  spo2_push(); //running sums and valley search move on by this sample
+  return k;
+}
+
+void sendSample(uint16_t k, bool withResult)
+{
+  if (binaryOut)
+  {
+    link_sample(redRing[k], irRing[k]); //a few bytes a sample, the result goes out on its own
+    return;
+  }
+
+  Serial.print(F("red="));
+  Serial.print(redRing[k], DEC);
+  Serial.print(F(", ir="));
+  if (!withResult)
+  {
+    Serial.println(irRing[k], DEC);
+    return;
+  }
+  Serial.print(irRing[k], DEC);
+
+  Serial.print(F(", HR="));
+  Serial.print(heartRate, DEC);
+
+  Serial.print(F(", HRvalid="));
+  Serial.print(validHeartRate, DEC);
+
+  Serial.print(F(", SPO2="));
+  Serial.print(spo2, DEC);
+
+  Serial.print(F(", SPO2Valid="));
+  Serial.println(validSPO2, DEC);
+}
+
+void sendResult()
+{
+  if (binaryOut)
+    link_result(heartRate, validHeartRate, spo2, validSPO2);
+}
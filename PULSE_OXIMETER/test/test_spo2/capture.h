@@ -0,0 +1,258 @@
+// Generated by make_capture.py, do not edit - red/IR samples at 25 per second, beats timed by the MIT-BIH
+// Arrhythmia Database record 208 ECG (Moody GB, Mark RG, IEEE Eng in Med and Biol 20(3):45-50, 2001; PhysioNet)
+// from 30 s of the SciPy excerpt on, 103 beats in 60 s.
+#define CAPTURE_LEN 1500
+static const uint32_t captureRed[CAPTURE_LEN] = {
+    95708, 95787, 95885, 95939, 95979, 96037, 96093, 96137, 96170, 96185, 96218, 96222,
+    96212, 96100, 95903, 95823, 95933, 96076, 96129, 96161, 96233, 96296, 96335, 96368,
+    96372, 96336, 96236, 96067, 96023, 96103, 96203, 96233, 96243, 96277, 96321, 96350,
+    96352, 96324, 96258, 96113, 95963, 95948, 96061, 96094, 96082, 96109, 96146, 96165,
+    96160, 96148, 96134, 96122, 96099, 95993, 95815, 95596, 95560, 95684, 95755, 95753,
+    95775, 95817, 95845, 95847, 95786, 95663, 95529, 95527, 95595, 95628, 95624, 95644,
+    95648, 95670, 95674, 95675, 95642, 95554, 95374, 95276, 95334, 95422, 95469, 95480,
+    95524, 95553, 95593, 95614, 95627, 95626, 95586, 95467, 95293, 95263, 95371, 95479,
+    95530, 95549, 95626, 95676, 95730, 95754, 95760, 95694, 95546, 95491, 95570, 95688,
+    95755, 95781, 95830, 95900, 95941, 95980, 96011, 96010, 95922, 95778, 95727, 95841,
+    95944, 96011, 96043, 96110, 96166, 96215, 96247, 96261, 96281, 96258, 96131, 95966,
+    95922, 96035, 96146, 96190, 96223, 96276, 96333, 96355, 96375, 96384, 96377, 96345,
+    96219, 96031, 95940, 96049, 96141, 96173, 96195, 96231, 96282, 96290, 96295, 96279,
+    96261, 96196, 96032, 95844, 95804, 95905, 95973, 95986, 95990, 96028, 96041, 96040,
+    96030, 96032, 95995, 95947, 95808, 95580, 95483, 95577, 95668, 95682, 95699, 95719,
+    95746, 95766, 95764, 95736, 95724, 95720, 95707, 95629, 95439, 95215, 95163, 95315,
+    95424, 95441, 95459, 95518, 95579, 95596, 95606, 95617, 95618, 95593, 95465, 95262,
+    95206, 95314, 95433, 95476, 95512, 95569, 95650, 95691, 95716, 95689, 95605, 95483,
+    95460, 95564, 95655, 95694, 95757, 95807, 95860, 95906, 95934, 95963, 95973, 96001,
+    96032, 96000, 95882, 95671, 95573, 95720, 95883, 95950, 95994, 96080, 96150, 96210,
+    96242, 96262, 96283, 96306, 96252, 96085, 95901, 95920, 96059, 96155, 96182, 96228,
+    96280, 96339, 96374, 96363, 96298, 96161, 96060, 96112, 96209, 96232, 96246, 96270,
+    96296, 96300, 96314, 96302, 96296, 96233, 96108, 95905, 95838, 95909, 95995, 96019,
+    96008, 96047, 96081, 96078, 96070, 96059, 96033, 96012, 95900, 95675, 95523, 95540,
+    95656, 95704, 95698, 95720, 95754, 95765, 95780, 95780, 95761, 95730, 95723, 95626,
+    95426, 95238, 95243, 95370, 95454, 95455, 95493, 95548, 95601, 95607, 95620, 95627,
+    95615, 95621, 95595, 95480, 95268, 95132, 95230, 95368, 95440, 95483, 95539, 95604,
+    95662, 95707, 95719, 95740, 95753, 95776, 95791, 95804, 95826, 95847, 95867, 95882,
+    95910, 95922, 95940, 95975, 95988, 95995, 96032, 96048, 96077, 96090, 96120, 96142,
+    96151, 96174, 96195, 96208, 96227, 96241, 96268, 96276, 96292, 96214, 95983, 95727,
+    95710, 95910, 96051, 96104, 96153, 96257, 96325, 96367, 96375, 96387, 96361, 96262,
+    96070, 95983, 96040, 96150, 96177, 96199, 96229, 96288, 96296, 96302, 96285, 96279,
+    96259, 96245, 96180, 95993, 95768, 95666, 95785, 95890, 95895, 95925, 95944, 95990,
+    96014, 95995, 95990, 95966, 95918, 95781, 95568, 95448, 95531, 95607, 95645, 95645,
+    95671, 95715, 95729, 95719, 95622, 95473, 95404, 95465, 95539, 95538, 95545, 95570,
+    95603, 95621, 95627, 95612, 95611, 95627, 95598, 95498, 95281, 95148, 95223, 95366,
+    95435, 95464, 95521, 95598, 95650, 95688, 95704, 95683, 95594, 95444, 95401, 95492,
+    95613, 95664, 95707, 95754, 95830, 95868, 95923, 95934, 95955, 95981, 95996, 96020,
+    96045, 96037, 95928, 95680, 95493, 95601, 95812, 95909, 95954, 96049, 96141, 96198,
+    96256, 96281, 96300, 96302, 96286, 96170, 95992, 95890, 95993, 96129, 96188, 96214,
+    96273, 96321, 96362, 96385, 96352, 96261, 96115, 96047, 96109, 96186, 96217, 96233,
+    96254, 96291, 96297, 96298, 96282, 96267, 96188, 96052, 95848, 95807, 95911, 95971,
+    95975, 95989, 96020, 96036, 96055, 96037, 96012, 95931, 95790, 95612, 95577, 95683,
+    95723, 95728, 95731, 95763, 95786, 95792, 95784, 95763, 95693, 95549, 95369, 95335,
+    95436, 95499, 95503, 95528, 95571, 95606, 95622, 95631, 95622, 95590, 95497, 95330,
+    95231, 95303, 95412, 95449, 95479, 95540, 95583, 95626, 95636, 95660, 95682, 95695,
+    95683, 95583, 95392, 95283, 95398, 95546, 95598, 95642, 95724, 95794, 95849, 95888,
+    95918, 95869, 95743, 95647, 95692, 95815, 95898, 95931, 95998, 96041, 96105, 96134,
+    96165, 96183, 96191, 96132, 95971, 95848, 95900, 96047, 96115, 96155, 96202, 96273,
+    96317, 96347, 96359, 96374, 96369, 96370, 96378, 96332, 96164, 95930, 95841, 95987,
+    96112, 96145, 96175, 96239, 96288, 96325, 96321, 96300, 96305, 96298, 96232, 96082,
+    95850, 95762, 95866, 95957, 95978, 96000, 96031, 96069, 96077, 96080, 96055, 96010,
+    95915, 95729, 95581, 95605, 95710, 95737, 95743, 95761, 95781, 95805, 95792, 95782,
+    95775, 95759, 95741, 95661, 95496, 95262, 95210, 95317, 95425, 95450, 95477, 95534,
+    95587, 95620, 95602, 95618, 95617, 95618, 95530, 95366, 95187, 95214, 95336, 95424,
+    95456, 95510, 95578, 95638, 95673, 95701, 95707, 95715, 95674, 95547, 95371, 95381,
+    95527, 95639, 95681, 95728, 95807, 95873, 95923, 95953, 95968, 95981, 96020, 96026,
+    95982, 95812, 95623, 95618, 95793, 95911, 95965, 96025, 96109, 96186, 96224, 96254,
+    96211, 96128, 95992, 96004, 96108, 96191, 96208, 96250, 96312, 96333, 96361, 96387,
+    96398, 96350, 96238, 96069, 95990, 96075, 96174, 96196, 96213, 96263, 96295, 96304,
+    96312, 96285, 96172, 96002, 95932, 96009, 96076, 96086, 96091, 96105, 96137, 96141,
+    96124, 96111, 96094, 96071, 96057, 96026, 95969, 95796, 95510, 95369, 95477, 95614,
+    95647, 95657, 95705, 95745, 95783, 95782, 95771, 95747, 95740, 95686, 95546, 95330,
+    95222, 95297, 95420, 95461, 95471, 95520, 95575, 95600, 95614, 95615, 95616, 95619,
+    95616, 95614, 95603, 95457, 95227, 95058, 95169, 95344, 95416, 95470, 95540, 95612,
+    95701, 95718, 95675, 95579, 95491, 95520, 95626, 95708, 95724, 95797, 95839, 95897,
+    95924, 95951, 95977, 95995, 96032, 96040, 96007, 95866, 95655, 95590, 95752, 95903,
+    95961, 96013, 96090, 96181, 96224, 96250, 96182, 96079, 96009, 96068, 96172, 96213,
+    96242, 96269, 96310, 96356, 96376, 96385, 96377, 96377, 96381, 96330, 96186, 95965,
+    95869, 95966, 96092, 96143, 96168, 96202, 96265, 96284, 96303, 96269, 96172, 96012,
+    95880, 95925, 96018, 96035, 96031, 96046, 96069, 96077, 96081, 96048, 96037, 96021,
+    95970, 95841, 95591, 95460, 95541, 95636, 95672, 95688, 95708, 95756, 95770, 95774,
+    95750, 95713, 95580, 95404, 95339, 95413, 95498, 95511, 95532, 95560, 95589, 95632,
+    95596, 95534, 95390, 95311, 95358, 95453, 95480, 95511, 95547, 95590, 95614, 95630,
+    95638, 95651, 95664, 95681, 95596, 95428, 95247, 95307, 95469, 95553, 95595, 95656,
+    95746, 95806, 95858, 95881, 95895, 95920, 95928, 95874, 95729, 95552, 95579, 95745,
+    95868, 95905, 95952, 96041, 96103, 96156, 96142, 96062, 95948, 95947, 96063, 96129,
+    96162, 96205, 96248, 96303, 96336, 96352, 96347, 96367, 96363, 96359, 96247, 96028,
+    95899, 95972, 96117, 96171, 96194, 96237, 96296, 96336, 96342, 96342, 96304, 96171,
+    96001, 95944, 96035, 96108, 96119, 96136, 96143, 96175, 96177, 96174, 96145, 96125,
+    96118, 96075, 95934, 95699, 95544, 95622, 95723, 95758, 95765, 95801, 95837, 95869,
+    95864, 95833, 95737, 95573, 95456, 95472, 95578, 95598, 95597, 95612, 95642, 95653,
+    95670, 95656, 95645, 95643, 95632, 95513, 95296, 95165, 95232, 95362, 95422, 95435,
+    95493, 95549, 95603, 95625, 95585, 95487, 95380, 95381, 95463, 95538, 95574, 95617,
+    95662, 95721, 95757, 95778, 95793, 95810, 95829, 95846, 95849, 95737, 95526, 95384,
+    95490, 95671, 95760, 95804, 95877, 95981, 96042, 96091, 96127, 96078, 95983, 95846,
+    95865, 95995, 96079, 96108, 96149, 96203, 96246, 96293, 96314, 96328, 96345, 96348,
+    96363, 96358, 96365, 96372, 96378, 96378, 96354, 96203, 95916, 95724, 95831, 96019,
+    96093, 96118, 96177, 96249, 96297, 96300, 96292, 96238, 96081, 95935, 95925, 96023,
+    96066, 96062, 96078, 96112, 96118, 96112, 96102, 96102, 96068, 96043, 95991, 95837,
+    95600, 95463, 95563, 95665, 95693, 95695, 95743, 95774, 95795, 95802, 95788, 95781,
+    95727, 95610, 95423, 95273, 95341, 95455, 95487, 95504, 95539, 95581, 95608, 95613,
+    95626, 95618, 95617, 95613, 95537, 95358, 95164, 95161, 95317, 95416, 95452, 95493,
+    95556, 95623, 95662, 95685, 95697, 95719, 95732, 95722, 95621, 95418, 95304, 95414,
+    95577, 95644, 95700, 95767, 95855, 95907, 95951, 95976, 96006, 96022, 96047, 96025,
+    95929, 95703, 95614, 95732, 95898, 95972, 96022, 96089, 96166, 96217, 96255, 96288,
+    96308, 96310, 96236, 96080, 95923, 95939, 96082, 96177, 96203, 96243, 96300, 96347,
+    96368, 96369, 96369, 96367, 96385, 96360, 96268, 96062, 95852, 95871, 96014, 96080,
+    96105, 96136, 96190, 96228, 96237, 96227, 96221, 96195, 96101, 95902, 95733, 95755,
+    95851, 95901, 95914, 95913, 95943, 95968, 95959, 95956, 95930, 95911, 95891, 95875,
+    95833, 95666, 95397, 95243, 95339, 95479, 95520, 95519, 95570, 95628, 95654, 95661,
+    95662, 95658, 95651, 95638, 95634, 95570, 95399, 95140, 95068, 95221, 95348, 95391,
+    95431, 95496, 95590, 95615, 95634, 95651, 95653, 95676, 95667, 95692, 95668, 95528,
+    95304, 95181, 95308, 95503, 95569, 95602, 95684, 95798, 95867, 95898, 95922, 95894,
+    95809, 95667, 95653, 95783, 95870, 95918, 95974, 96032, 96094, 96141, 96160, 96192,
+    96211, 96225, 96246, 96264, 96272, 96237, 96080, 95809, 95714, 95861, 96046, 96099,
+    96133, 96220, 96300, 96367, 96375, 96386, 96381, 96389, 96375, 96369, 96265, 96067,
+    95837, 95869, 96014, 96098, 96121, 96156, 96202, 96246, 96261, 96252, 96189, 96073,
+    95896, 95857, 95960, 95989, 96004, 96013, 96016, 96036, 96044, 96030, 96011, 95993,
+    95971, 95943, 95879, 95705, 95438, 95338, 95454, 95571, 95595, 95604, 95644, 95699,
+    95718, 95723, 95710, 95700, 95681, 95649, 95536, 95316, 95170, 95232, 95366, 95418,
+    95440, 95491, 95551, 95588, 95602, 95611, 95613, 95632, 95630, 95594, 95450, 95233,
+    95170, 95328, 95452, 95491, 95544, 95620, 95695, 95735, 95776, 95795, 95815, 95832,
+    95839, 95757, 95570, 95420, 95509, 95675, 95764, 95803, 95871, 95962, 96031, 96061,
+    96108, 96129, 96142, 96164, 96164, 96071, 95874, 95716, 95790, 95970, 96060, 96091,
+    96151, 96231, 96290, 96327, 96351, 96364, 96356, 96356, 96258, 96064, 95912, 95980,
+    96116, 96174, 96211, 96246, 96309, 96335, 96353, 96355, 96341, 96332, 96332, 96309,
+    96271, 96126, 95884, 95693, 95754, 95909, 95959, 95971, 96001, 96062, 96103, 96095,
+    96090, 96056, 96014, 95863, 95655, 95580, 95680, 95745, 95750, 95770, 95785, 95813,
+    95829, 95797, 95724, 95579, 95466, 95482, 95564, 95593, 95590, 95592, 95635, 95643,
+    95649, 95658, 95651, 95636, 95627, 95630, 95533, 95342, 95135, 95105, 95265, 95382,
+    95413, 95450, 95524, 95598, 95628, 95656, 95669, 95676, 95599, 95478, 95331, 95353,
+    95492, 95589, 95631, 95679, 95737, 95801, 95845, 95878, 95909, 95923, 95942, 95932,
+    95821, 95626, 95510, 95642, 95803, 95877, 95920, 95994, 96074, 96145, 96177, 96206,
+    96204, 96134, 95992, 95889, 95965, 96094, 96154, 96171, 96237, 96287, 96334, 96350,
+};
+static const uint32_t captureIr[CAPTURE_LEN] = {
+    114353, 114519, 114720, 114808, 114864, 114962, 115073, 115155, 115198, 115226, 115246, 115268,
+    115223, 114960, 114530, 114320, 114556, 114862, 114958, 115040, 115156, 115308, 115374, 115438,
+    115448, 115380, 115140, 114779, 114656, 114860, 115073, 115118, 115168, 115257, 115339, 115391,
+    115402, 115392, 115251, 114943, 114614, 114615, 114841, 114962, 114986, 115019, 115103, 115169,
+    115191, 115179, 115171, 115124, 115111, 114926, 114532, 114083, 114034, 114327, 114497, 114533,
+    114581, 114688, 114772, 114796, 114679, 114421, 114161, 114182, 114353, 114438, 114442, 114492,
+    114554, 114589, 114602, 114602, 114552, 114360, 114024, 113764, 113886, 114119, 114198, 114241,
+    114320, 114415, 114490, 114535, 114542, 114549, 114462, 114194, 113811, 113726, 113981, 114186,
+    114268, 114342, 114457, 114588, 114658, 114703, 114681, 114529, 114209, 114040, 114208, 114446,
+    114545, 114606, 114728, 114835, 114937, 114975, 115020, 114978, 114768, 114446, 114299, 114525,
+    114767, 114855, 114925, 115037, 115154, 115246, 115302, 115325, 115342, 115262, 115001, 114608,
+    114503, 114745, 114975, 115051, 115118, 115227, 115356, 115423, 115444, 115469, 115449, 115394,
+    115117, 114689, 114510, 114742, 114971, 115039, 115088, 115170, 115277, 115340, 115347, 115333,
+    115300, 115184, 114865, 114458, 114370, 114615, 114782, 114817, 114844, 114938, 115024, 115056,
+    115064, 115027, 114998, 114886, 114605, 114155, 113953, 114176, 114385, 114438, 114466, 114558,
+    114655, 114700, 114699, 114696, 114680, 114663, 114645, 114465, 114096, 113615, 113528, 113841,
+    114061, 114127, 114193, 114327, 114441, 114511, 114536, 114540, 114541, 114466, 114192, 113773,
+    113624, 113864, 114106, 114206, 114263, 114399, 114521, 114604, 114651, 114597, 114382, 114091,
+    114044, 114254, 114436, 114528, 114589, 114694, 114804, 114883, 114910, 114951, 114988, 115004,
+    115016, 114967, 114680, 114185, 113991, 114268, 114596, 114721, 114818, 114969, 115120, 115236,
+    115276, 115317, 115339, 115362, 115219, 114884, 114490, 114465, 114762, 114982, 115050, 115127,
+    115259, 115369, 115434, 115433, 115253, 114954, 114767, 114887, 115082, 115133, 115171, 115235,
+    115315, 115368, 115377, 115366, 115347, 115248, 114978, 114557, 114377, 114589, 114798, 114845,
+    114879, 114962, 115043, 115071, 115081, 115065, 115042, 115000, 114780, 114347, 113999, 114059,
+    114339, 114454, 114472, 114541, 114639, 114720, 114722, 114722, 114702, 114699, 114667, 114462,
+    114063, 113632, 113660, 113973, 114128, 114167, 114251, 114370, 114470, 114518, 114540, 114538,
+    114560, 114545, 114505, 114251, 113786, 113481, 113652, 113982, 114119, 114187, 114329, 114468,
+    114574, 114628, 114664, 114707, 114703, 114718, 114754, 114769, 114803, 114813, 114832, 114858,
+    114885, 114907, 114931, 114952, 114990, 115023, 115033, 115068, 115088, 115112, 115129, 115163,
+    115179, 115211, 115235, 115244, 115276, 115286, 115313, 115334, 115344, 115148, 114643, 114064,
+    114027, 114485, 114776, 114857, 114988, 115169, 115329, 115408, 115454, 115455, 115419, 115178,
+    114810, 114576, 114739, 114983, 115064, 115098, 115174, 115281, 115328, 115346, 115344, 115338,
+    115302, 115290, 115165, 114805, 114307, 114112, 114383, 114621, 114690, 114723, 114844, 114945,
+    114994, 114999, 114981, 114965, 114870, 114611, 114147, 113920, 114109, 114334, 114400, 114431,
+    114510, 114606, 114665, 114623, 114430, 114144, 114003, 114149, 114302, 114334, 114351, 114414,
+    114481, 114537, 114549, 114542, 114545, 114545, 114496, 114257, 113812, 113507, 113677, 113987,
+    114124, 114172, 114297, 114441, 114541, 114616, 114639, 114596, 114401, 114052, 113921, 114119,
+    114351, 114449, 114517, 114619, 114752, 114842, 114891, 114910, 114945, 114973, 114997, 115025,
+    115049, 115020, 114744, 114184, 113776, 114008, 114439, 114631, 114721, 114885, 115072, 115222,
+    115298, 115340, 115342, 115383, 115316, 115047, 114636, 114411, 114640, 114925, 115025, 115098,
+    115211, 115333, 115400, 115440, 115404, 115203, 114874, 114713, 114887, 115066, 115121, 115142,
+    115222, 115302, 115327, 115346, 115342, 115316, 115189, 114873, 114467, 114366, 114602, 114774,
+    114820, 114836, 114928, 115003, 115045, 115053, 115017, 114858, 114552, 114205, 114161, 114398,
+    114511, 114532, 114569, 114639, 114708, 114731, 114717, 114712, 114573, 114285, 113908, 113835,
+    114068, 114221, 114253, 114324, 114411, 114479, 114541, 114553, 114546, 114495, 114276, 113901,
+    113671, 113847, 114085, 114187, 114235, 114340, 114447, 114522, 114563, 114606, 114616, 114638,
+    114592, 114357, 113926, 113677, 113904, 114198, 114331, 114409, 114544, 114705, 114802, 114872,
+    114890, 114765, 114500, 114234, 114327, 114584, 114720, 114784, 114886, 115005, 115093, 115160,
+    115192, 115234, 115217, 115049, 114684, 114396, 114527, 114821, 114959, 115039, 115131, 115254,
+    115360, 115401, 115424, 115441, 115440, 115449, 115455, 115350, 114997, 114458, 114280, 114577,
+    114869, 114954, 115026, 115153, 115286, 115365, 115385, 115383, 115367, 115351, 115240, 114920,
+    114437, 114259, 114504, 114733, 114792, 114834, 114924, 115015, 115083, 115088, 115067, 115010,
+    114815, 114428, 114104, 114182, 114427, 114516, 114528, 114604, 114683, 114740, 114757, 114745,
+    114725, 114710, 114689, 114550, 114189, 113703, 113573, 113869, 114098, 114158, 114218, 114332,
+    114445, 114514, 114533, 114546, 114549, 114533, 114361, 113976, 113611, 113631, 113942, 114128,
+    114191, 114277, 114420, 114536, 114597, 114635, 114653, 114677, 114536, 114217, 113850, 113873,
+    114172, 114372, 114442, 114540, 114694, 114804, 114888, 114931, 114959, 114990, 115018, 115040,
+    114900, 114528, 114076, 114063, 114424, 114667, 114751, 114861, 115026, 115166, 115259, 115303,
+    115215, 114973, 114688, 114689, 114921, 115073, 115133, 115195, 115296, 115378, 115426, 115459,
+    115459, 115401, 115150, 114770, 114591, 114788, 115026, 115069, 115123, 115211, 115309, 115364,
+    115390, 115319, 115085, 114744, 114591, 114766, 114929, 114964, 114999, 115055, 115119, 115152,
+    115150, 115145, 115104, 115080, 115063, 115039, 114916, 114558, 113978, 113681, 113936, 114248,
+    114340, 114382, 114508, 114641, 114719, 114729, 114721, 114701, 114677, 114593, 114315, 113819,
+    113606, 113820, 114080, 114152, 114217, 114304, 114420, 114508, 114530, 114549, 114541, 114541,
+    114544, 114544, 114493, 114193, 113667, 113324, 113548, 113924, 114078, 114161, 114302, 114458,
+    114591, 114640, 114557, 114298, 114081, 114158, 114385, 114514, 114567, 114647, 114766, 114850,
+    114909, 114936, 114975, 115001, 115026, 115050, 114980, 114629, 114127, 113976, 114313, 114619,
+    114745, 114826, 114999, 115150, 115247, 115279, 115134, 114854, 114700, 114841, 115055, 115125,
+    115167, 115253, 115343, 115406, 115438, 115448, 115464, 115461, 115454, 115367, 115044, 114552,
+    114334, 114607, 114881, 114960, 115033, 115129, 115260, 115327, 115334, 115308, 115095, 114768,
+    114539, 114622, 114834, 114900, 114921, 114968, 115045, 115078, 115067, 115076, 115049, 115020,
+    114951, 114658, 114185, 113913, 114069, 114337, 114426, 114452, 114546, 114634, 114716, 114720,
+    114709, 114621, 114366, 113985, 113841, 114030, 114211, 114263, 114304, 114392, 114478, 114530,
+    114520, 114359, 114073, 113888, 114003, 114186, 114265, 114298, 114375, 114461, 114532, 114558,
+    114579, 114594, 114607, 114594, 114419, 114005, 113655, 113739, 114076, 114268, 114344, 114454,
+    114606, 114730, 114808, 114847, 114877, 114904, 114923, 114785, 114408, 114038, 114063, 114394,
+    114625, 114706, 114807, 114962, 115092, 115170, 115125, 114931, 114676, 114656, 114873, 115047,
+    115091, 115153, 115252, 115323, 115392, 115413, 115427, 115432, 115446, 115398, 115165, 114703,
+    114383, 114544, 114875, 114994, 115049, 115151, 115275, 115375, 115415, 115403, 115313, 115071,
+    114698, 114598, 114797, 114964, 114993, 115028, 115106, 115165, 115196, 115207, 115181, 115157,
+    115138, 115059, 114780, 114289, 113978, 114145, 114429, 114512, 114555, 114637, 114744, 114802,
+    114824, 114781, 114600, 114253, 114007, 114107, 114302, 114364, 114398, 114450, 114523, 114585,
+    114590, 114601, 114582, 114579, 114526, 114295, 113831, 113535, 113681, 113988, 114116, 114169,
+    114263, 114403, 114498, 114543, 114457, 114233, 113961, 113953, 114170, 114322, 114375, 114444,
+    114541, 114626, 114703, 114724, 114739, 114778, 114798, 114811, 114797, 114556, 114057, 113735,
+    113948, 114319, 114485, 114567, 114736, 114889, 115016, 115088, 115139, 115037, 114780, 114501,
+    114511, 114769, 114937, 114993, 115076, 115187, 115285, 115358, 115373, 115395, 115412, 115412,
+    115425, 115429, 115447, 115455, 115447, 115450, 115392, 115060, 114435, 114027, 114266, 114672,
+    114826, 114898, 115043, 115202, 115325, 115362, 115349, 115222, 114922, 114604, 114587, 114803,
+    114929, 114943, 114991, 115058, 115110, 115137, 115130, 115109, 115082, 115040, 114954, 114628,
+    114129, 113881, 114090, 114370, 114448, 114472, 114563, 114677, 114731, 114750, 114739, 114725,
+    114669, 114410, 113993, 113709, 113861, 114109, 114214, 114231, 114326, 114436, 114513, 114547,
+    114550, 114542, 114543, 114548, 114375, 113982, 113558, 113553, 113868, 114085, 114151, 114242,
+    114392, 114516, 114583, 114619, 114641, 114656, 114684, 114640, 114417, 113966, 113684, 113884,
+    114233, 114364, 114452, 114589, 114744, 114860, 114936, 114969, 114997, 115028, 115055, 115000,
+    114737, 114266, 114034, 114290, 114619, 114758, 114843, 114978, 115142, 115253, 115309, 115333,
+    115360, 115358, 115217, 114852, 114489, 114538, 114831, 115010, 115068, 115163, 115276, 115389,
+    115439, 115452, 115460, 115448, 115455, 115434, 115219, 114775, 114336, 114372, 114705, 114889,
+    114919, 115008, 115135, 115221, 115273, 115275, 115260, 115222, 115021, 114613, 114278, 114344,
+    114595, 114700, 114723, 114781, 114873, 114937, 114951, 114937, 114917, 114885, 114867, 114837,
+    114752, 114427, 113862, 113550, 113770, 114093, 114182, 114239, 114345, 114474, 114574, 114594,
+    114590, 114585, 114578, 114573, 114565, 114436, 114052, 113523, 113358, 113678, 113953, 114055,
+    114136, 114285, 114416, 114516, 114555, 114583, 114598, 114608, 114623, 114631, 114568, 114262,
+    113730, 113449, 113743, 114103, 114233, 114325, 114494, 114666, 114789, 114876, 114913, 114829,
+    114606, 114277, 114226, 114483, 114699, 114763, 114836, 114964, 115084, 115160, 115192, 115232,
+    115243, 115271, 115295, 115319, 115337, 115239, 114870, 114276, 114020, 114365, 114746, 114859,
+    114953, 115122, 115281, 115398, 115437, 115440, 115456, 115464, 115455, 115451, 115236, 114758,
+    114310, 114329, 114695, 114882, 114926, 115017, 115150, 115257, 115296, 115310, 115190, 114893,
+    114567, 114512, 114719, 114839, 114863, 114890, 114972, 115018, 115042, 115022, 115022, 114987,
+    114963, 114936, 114818, 114425, 113900, 113698, 113973, 114225, 114298, 114342, 114461, 114578,
+    114637, 114661, 114646, 114625, 114621, 114561, 114314, 113850, 113520, 113676, 113973, 114108,
+    114150, 114249, 114383, 114480, 114532, 114540, 114557, 114557, 114550, 114463, 114141, 113673,
+    113508, 113823, 114104, 114188, 114281, 114437, 114572, 114660, 114713, 114750, 114781, 114794,
+    114790, 114573, 114158, 113830, 114002, 114349, 114510, 114577, 114721, 114876, 115002, 115083,
+    115131, 115147, 115160, 115188, 115198, 114964, 114512, 114159, 114300, 114679, 114848, 114916,
+    115044, 115201, 115327, 115402, 115406, 115435, 115436, 115413, 115183, 114752, 114447, 114597,
+    114895, 115023, 115064, 115175, 115292, 115388, 115411, 115409, 115411, 115412, 115386, 115372,
+    115312, 115027, 114475, 114065, 114230, 114577, 114714, 114751, 114851, 114989, 115081, 115095,
+    115102, 115084, 114951, 114646, 114226, 114112, 114334, 114512, 114536, 114586, 114654, 114739,
+    114765, 114752, 114593, 114274, 114043, 114102, 114307, 114371, 114384, 114438, 114509, 114558,
+    114584, 114575, 114570, 114558, 114542, 114549, 114382, 113964, 113473, 113427, 113779, 114016,
+    114100, 114174, 114326, 114464, 114547, 114581, 114610, 114604, 114456, 114123, 113794, 113853,
+    114152, 114321, 114388, 114495, 114622, 114740, 114797, 114845, 114875, 114901, 114932, 114904,
+    114641, 114191, 113942, 114187, 114512, 114647, 114740, 114870, 115029, 115152, 115208, 115246,
+    115231, 115063, 114726, 114489, 114629, 114903, 115010, 115069, 115170, 115285, 115374, 115416,
+};
@@ -0,0 +1,97 @@
+# Writes capture.h, the red/IR fixture of test_spo2, as the oximeter would send it (25 samples per second, 18 bit).
+# No sensor recording is used: the beats are timed by a real ECG, the MIT-BIH Arrhythmia Database record 208
+# excerpt (lead MLII, 360 Hz, 5 minutes, with frequent premature ventricular beats - RR 0.43 to 1.7 s here) that SciPy ships as
+# electrocardiogram(). Every R wave starts a pulse 200 ms later whose height follows the RR interval before it,
+# the pulse shape, perfusion, breathing, SpO2 ratio and noise are modelled. Fixed seed, the output never changes.
+#   python test/test_spo2/make_capture.py > test/test_spo2/capture.h
+#   python test/test_spo2/make_capture.py --ecg path/to/scipy/misc/ecg.dat > test/test_spo2/capture.h
+import argparse
+import math
+import random
+
+import numpy as np
+
+ECG_FS = 360
+SENSOR_FS = 100         # sampleRate of the sketch
+AVERAGE = 4             # sampleAverage of the sketch, 25 samples per second come out
+SECONDS = 60
+START_S = 30            # where the excerpt is taken from the record
+PTT_S = 0.2             # R wave to pulse arrival
+IR_DC, RED_DC = 115000, 96000
+IR_AC = 0.012           # perfusion index of the IR
+RATIO = 0.55            # (AC/DC red) / (AC/DC IR), about 97% on the reference curve
+NOISE = 12              # counts rms
+
+
+def load_ecg(path):
+    if path:
+        return (np.load(path)["ecg"].astype(float) - 1024) / 200
+    try:
+        from scipy.datasets import electrocardiogram
+    except ImportError:
+        from scipy.misc import electrocardiogram
+    return electrocardiogram()
+
+
+def r_waves(ecg):
+    """R wave times in seconds - peaks of the slope energy over 150 ms above 5% of its 99th percentile,
+    the highest one within 350 ms"""
+    energy = np.convolve(np.diff(ecg) ** 2, np.ones(int(0.15 * ECG_FS)), "same")
+    level = 0.05 * np.percentile(energy, 99)
+    peaks = []
+    for i in range(1, len(energy) - 1):
+        if energy[i] <= level or energy[i] < energy[i - 1] or energy[i] <= energy[i + 1]:
+            continue
+        if not peaks or i - peaks[-1] > 0.35 * ECG_FS:
+            peaks.append(i)
+        elif energy[i] > energy[peaks[-1]]:
+            peaks[-1] = i
+    return [i / ECG_FS for i in peaks]
+
+
+def pulse(t):
+    """one pulse of blood volume, t in seconds after its arrival - systolic rise and fall, the dicrotic wave a shoulder
+    on the fall rather than a second maximum"""
+    if t < 0 or t > 1.2:
+        return 0.0
+    return math.exp(-((t - 0.12) / 0.07) ** 2) + 0.4 * math.exp(-((t - 0.26) / 0.1) ** 2)
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--ecg", help="ecg.dat of SciPy instead of importing it")
+    args = parser.parse_args()
+
+    beats = [t - START_S for t in r_waves(load_ecg(args.ecg)) if START_S - 2 <= t < START_S + SECONDS]
+    rng = random.Random(208)
+    red, ir = [], []
+    for n in range(SECONDS * SENSOR_FS // AVERAGE):
+        sums = [0.0, 0.0]
+        for k in range(AVERAGE):
+            t = (n * AVERAGE + k) / SENSOR_FS
+            volume = 0.0
+            for i in range(1, len(beats)):
+                #a short RR interval fills the heart less, its pulse is weaker
+                rr = beats[i] - beats[i - 1]
+                volume += min(1.0, (rr / 0.75) ** 1.5) * pulse(t - beats[i] - PTT_S)
+            breath = math.sin(2 * math.pi * 0.22 * t)
+            ir_dc = IR_DC * (1 + 0.004 * breath)
+            red_dc = RED_DC * (1 + 0.004 * breath)
+            sums[0] += red_dc * (1 - IR_AC * RATIO * volume) + rng.gauss(0, NOISE)
+            sums[1] += ir_dc * (1 - IR_AC * volume) + rng.gauss(0, NOISE)
+        red.append(int(round(sums[0] / AVERAGE)) & 0x3FFFF)
+        ir.append(int(round(sums[1] / AVERAGE)) & 0x3FFFF)
+
+    print("// Generated by make_capture.py, do not edit - red/IR samples at 25 per second, beats timed by the MIT-BIH")
+    print("// Arrhythmia Database record 208 ECG (Moody GB, Mark RG, IEEE Eng in Med and Biol 20(3):45-50, 2001; PhysioNet)")
+    print("// from %d s of the SciPy excerpt on, %d beats in %d s." % (START_S, sum(1 for t in beats if t >= 0), SECONDS))
+    print("#define CAPTURE_LEN %d" % len(ir))
+    for name, values in (("captureRed", red), ("captureIr", ir)):
+        print("static const uint32_t %s[CAPTURE_LEN] = {" % name)
+        for i in range(0, len(values), 12):
+            print("    " + ", ".join(str(v) for v in values[i:i + 12]) + ",")
+        print("};")
+
+
+if __name__ == "__main__":
+    main()
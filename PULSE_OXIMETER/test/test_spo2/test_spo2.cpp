@@ -0,0 +1,131 @@
+#include <stdio.h>
+#include <unity.h>
+#include <Spo2.h>
+#include "capture.h"
+
+// Runs the red/IR capture of capture.h (make_capture.py, beats timed by a real ECG) through the stream the way the
+// sketch does and checks every window against spo2_calc() on the same ring: valid flags, SpO2 and heart rate must be
+// the same. The windows that end on the last samples of a valley, which spo2_calc() does not average, and the ones
+// whose mean has drifted since a valley was found are where the stream used to differ.
+// Runs on the host: pio test -e native
+
+#define SAMPLE_RING 128         //as the sketch
+#define WINDOW_LEN 100
+#define FIFO_AHEAD 24
+
+static spo2_sample_t irRing[SAMPLE_RING];
+static spo2_sample_t redRing[SAMPLE_RING];
+
+static uint16_t windows;        //windows compared
+static uint16_t hrValid;        //of them with a heart rate
+static uint16_t spo2Valid;      //of them with a SpO2
+
+//writes capture sample n into the rings
+static void put(uint16_t n){
+    irRing[n & (SAMPLE_RING - 1)] = captureIr[n];
+    redRing[n & (SAMPLE_RING - 1)] = captureRed[n];
+}
+
+//reads the stream after sample n was pushed and compares it with spo2_calc() on the window ending there
+static void compare(uint16_t n){
+
+    int32_t spo2, heartRate, calcSpo2, calcHeartRate;
+    int8_t spo2Ok, hrOk, calcSpo2Ok, calcHrOk;
+    spo2_read(&spo2, &spo2Ok, &heartRate, &hrOk);
+    if(n + 1 < WINDOW_LEN){
+        TEST_ASSERT_FALSE(spo2Ok);
+        TEST_ASSERT_FALSE(hrOk);
+        return;
+    }
+
+    Spo2Window w = {irRing, redRing, SAMPLE_RING - 1, (uint16_t)((n + 1 - WINDOW_LEN) & (SAMPLE_RING - 1)), WINDOW_LEN};
+    spo2_calc(&w, &calcSpo2, &calcSpo2Ok, &calcHeartRate, &calcHrOk);
+
+    char msg[48];
+    snprintf(msg, sizeof(msg), "window ending at sample %u", n);
+    TEST_ASSERT_EQUAL_INT8_MESSAGE(calcHrOk, hrOk, msg);
+    TEST_ASSERT_EQUAL_INT8_MESSAGE(calcSpo2Ok, spo2Ok, msg);
+    TEST_ASSERT_EQUAL_INT32_MESSAGE(calcHeartRate, heartRate, msg);
+    TEST_ASSERT_EQUAL_INT32_MESSAGE(calcSpo2, spo2, msg);
+
+    windows++;
+    hrValid += hrOk;
+    spo2Valid += spo2Ok;
+}
+
+void setUp(){
+    windows = 0;
+    hrValid = 0;
+    spo2Valid = 0;
+}
+
+void tearDown(){}
+
+//one sample written and pushed at a time
+void test_stream_matches_calc(){
+
+    spo2_begin(irRing, redRing, SAMPLE_RING - 1, WINDOW_LEN, 0);
+    for(uint16_t n = 0; n < CAPTURE_LEN; n++){
+        put(n);
+        spo2_push();
+        compare(n);
+    }
+    TEST_ASSERT_EQUAL_UINT16(CAPTURE_LEN - WINDOW_LEN + 1, windows);
+
+    //the capture is a clean pulse, the comparison is not one of two invalid results
+    TEST_ASSERT_GREATER_THAN_UINT16(windows * 9 / 10, hrValid);
+    TEST_ASSERT_GREATER_THAN_UINT16(windows * 9 / 10, spo2Valid);
+}
+
+//sensor bursts write up to FIFO_AHEAD samples past the last one pushed, as the sketch with the FIFO interrupt does
+void test_stream_matches_calc_with_bursts(){
+
+    spo2_begin(irRing, redRing, SAMPLE_RING - 1, WINDOW_LEN, FIFO_AHEAD);
+    uint16_t written = 0;
+    for(uint16_t n = 0; n < CAPTURE_LEN; n++){
+        if(written == n){
+            uint16_t burst = 1 + n % FIFO_AHEAD;
+            while(burst-- && written < CAPTURE_LEN){put(written++);}
+        }
+        spo2_push();
+        compare(n);
+    }
+    TEST_ASSERT_EQUAL_UINT16(CAPTURE_LEN - WINDOW_LEN + 1, windows);
+}
+
+//spo2_ratio() against the division it replaces, up to denominators where denom << 9 no longer fits 32 bits - they
+//come from 18 bit DC levels and AC swings of a few thousand counts, beat ratios near 0.3 used to come out near 5.4
+void test_ratio_matches_division(){
+
+    static const uint32_t denoms[] = {1, 7, 100, 65535, 1UL << 22, (1UL << 23) - 1, 1UL << 23, 12345678, 1UL << 25,
+                                      (1UL << 25) + 1, 98765432, 1UL << 30, 0x7FFFFFFF, 0xFFFFFFFF};
+    uint32_t seed = 1;
+    for(uint8_t i = 0; i < sizeof(denoms) / sizeof(denoms[0]); i++){
+        uint32_t denom = denoms[i];
+        for(uint16_t j = 0; j < 2000; j++){
+
+            //100 * |nume| < 2^31, mostly with quotients inside the table
+            seed = seed * 1103515245 + 12345;
+            uint32_t most = denom / 100 * 11 + 10;
+            if(most > 0x7FFFFFFF / 100){most = 0x7FFFFFFF / 100;}
+            int32_t nume = (seed >> 1) % most;
+            if(j & 1){nume = -nume;}
+
+            int64_t q = (int64_t)nume * 100 / denom;
+            if(q >= SPO2_RATIO_CAP){q = SPO2_RATIO_CAP - 1;}
+            if(q <= -SPO2_RATIO_CAP){q = -(SPO2_RATIO_CAP - 1);}
+
+            char msg[48];
+            snprintf(msg, sizeof(msg), "100 * %ld / %lu", (long)nume, (unsigned long)denom);
+            TEST_ASSERT_EQUAL_INT32_MESSAGE((int32_t)q, spo2_ratio(nume, denom), msg);
+        }
+    }
+}
+
+int main(){
+    UNITY_BEGIN();
+    RUN_TEST(test_stream_matches_calc);
+    RUN_TEST(test_stream_matches_calc_with_bursts);
+    RUN_TEST(test_ratio_matches_division);
+    return UNITY_END();
+}
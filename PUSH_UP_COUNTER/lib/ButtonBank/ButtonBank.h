@@ -0,0 +1,46 @@
+#ifndef BUTTONBANK_H
+#define BUTTONBANK_H
+
+#include <Arduino.h>
+
+#define BANK_PORTS 3            //ports B, C and D
+#define BANK_TICK_DIV 2         //Timer0 compare ticks (1.024ms each) per sample
+#define BANK_PINS 8             //most pins that can be registered
+#define BANK_EVENTS 16          //debounced events queued until taken, power of 2
+#define BANK_DOWN 0x80          //event code flag of a press, clear for a release
+
+/* |
+* @brief sampled button bank - the Timer0 compare B interrupt (Timer0 already runs for millis) reads
+*        PINB, PINC and PIND once every BANK_TICK_DIV ticks and debounces every registered bit of a port
+*        at once with a 2 bit vertical counter: a bit only changes state after 4 equal samples in a row
+*        (about 8ms). Buttons are active low with the internal pull up.
+*
+*        The pin change interrupt of every registered pin timestamps the edge that starts a change, and
+*        each debounced change is queued as a press or release event carrying that time, in the order the
+*        changes happened. An event only waits for the debounce, not for the next poll of the caller.
+*        A full queue drops new events, the debounced state stays right. The pin change vectors are the
+*        bank's, they also wake the MCU from Power's sleep.
+*/
+
+//debounced press or release of a registered pin
+struct BankEvent{
+    uint8_t code;               //slot of the pin (as returned by bank_add), BANK_DOWN set for a press
+    uint16_t ms;                //low 16 bits of millis() at the edge that started the change
+};
+
+extern volatile uint8_t bank_downBits[BANK_PORTS];     //debounced state of each port, set bit = down (written by the sampling only)
+extern volatile uint8_t bank_events;                   //events queued so far, wraps - a change means there is a new one
+
+uint8_t bank_add(uint8_t pin);                  //registers a button pin, starts the sampling and its pin change interrupt, returns the slot of the pin
+bool bank_takeEvent(BankEvent *e);              //oldest queued event, false when there is none
+uint8_t bank_slotPort(uint8_t slot);            //bank port of a registered slot
+uint8_t bank_slotBit(uint8_t slot);             //bit of a registered slot
+
+//bank port (0 B, 1 C, 2 D) and bit of a Nano (ATmega328P) pin, for pins known at compile time
+constexpr uint8_t bank_port(uint8_t pin){return pin <= 7 ? 2 : (pin <= 13 ? 0 : 1);}
+constexpr uint8_t bank_bit(uint8_t pin){return 1 << (pin <= 7 ? pin : (pin <= 13 ? pin - 8 : pin - 14));}
+
+//debounced down state of the port, one bit per pin - inline so a constant port is a single load
+static inline uint8_t bank_down(uint8_t port){return bank_downBits[port];}
+
+#endif
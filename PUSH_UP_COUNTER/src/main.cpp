@@ -1,5 +1,6 @@
 #include <TM1637Display.h>
 #include <Arduino.h>
+#include <Pressbutton.h>
 
 // HC-SR04
 #define echoPin 4
@@ -18,6 +19,12 @@
 #define DIO 9
 TM1637Display display(CLK, DIO);
 
+// Buttons, debounced together by the button bank
+PressButton<modePin> btnMode;
+PressButton<incTimePin> btnInc;
+PressButton<decTimePin> btnDec;
+PressButton<startTimerPin> btnStart;
+
 //FUNCTION FOR LOOP
 void handleTimerMode();
 void resetSystem();
@@ -36,19 +43,12 @@ volatile boolean timerMode = false;
 volatile long timerCountdown = 0;
 volatile boolean timerRunning = false;
 
-boolean lastModePinState = HIGH;
-
 void setup() {
   Serial.begin(9600);
   pinMode(trigPin, OUTPUT);
   pinMode(echoPin, INPUT);
-  pinMode(modePin, INPUT_PULLUP);
-  pinMode(incTimePin, INPUT_PULLUP);
-  pinMode(decTimePin, INPUT_PULLUP);
-  pinMode(startTimerPin, INPUT_PULLUP);
   pinMode(buzzerPin, OUTPUT);
   pinMode(ledPin, OUTPUT);
-  attachInterrupt(digitalPinToInterrupt(modePin),handleTimerMode, CHANGE);
 
 
   display.setBrightness(4);
@@ -58,17 +58,15 @@ void setup() {
 }
 
 void loop() {
-  
-  boolean currentModePinState = digitalRead(modePin);
 
-  if (currentModePinState == LOW && lastModePinState == HIGH) {
+  // Take the presses latched since the last pass (also the ones made during pulseIn and delay)
+  PressButtonBase::Dispatch();
+
+  if (btnMode.ClearWasDown()) {
     timerMode = !timerMode;
     resetSystem();
-    delay(500); // Debounce delay
   }
 
-  lastModePinState = currentModePinState;
-
   if (timerMode) {
     handleTimerMode();
   } else {
@@ -86,6 +84,9 @@ void resetSystem() {
   digitalWrite(buzzerPin, LOW);
   digitalWrite(ledPin, LOW);
   display.clear();
+  btnInc.ClearWasDown();
+  btnDec.ClearWasDown();
+  btnStart.ClearWasDown();
 }
 
 void handlePushUpCounter() {
@@ -126,21 +127,22 @@ void handlePushUpCounter() {
 }
 
 void handleTimerMode() {
-  if (digitalRead(incTimePin) == LOW) {
+  // Held buttons keep repeating
+  btnInc.CaptureDownState();
+  btnDec.CaptureDownState();
+
+  if (btnInc.Repeated()) {
     timerCountdown += 1;
     display.showNumberDecEx(timerCountdown, false, true, 4, 0);
-    delay(200); // Debounce delay
   }
 
-  if (digitalRead(decTimePin) == LOW && timerCountdown > 0) {
+  if (btnDec.Repeated() && timerCountdown > 0) {
     timerCountdown -= 1;
     display.showNumberDecEx(timerCountdown, false, true, 4, 0);
-    delay(200); // Debounce delay
   }
 
-  if (digitalRead(startTimerPin) == LOW && !timerRunning && timerCountdown > 0) {
+  if (btnStart.ClearWasDown() && !timerRunning && timerCountdown > 0) {
     timerRunning = true;
-    delay(200); // Debounce delay
   }
 
   if (timerRunning) {
@@ -0,0 +1,31 @@
+// Runs the benches in bench/ one after the other, the results go out on the serial port at 115200
+// in simavr, no board needed (the results come out on the console):  pio run -e bench -t upload
+// on a board, flash .pio/build/bench/firmware.hex as the sketch is and watch the serial monitor
+#include <Arduino.h>
+#include <avr/sleep.h>
+#include "bench.h"
+
+void startCycles(){TCCR1A = 0; TCCR1B = _BV(CS10); TCNT1 = 0;}
+uint16_t stopCycles(){return TCNT1;}
+
+void report(const __FlashStringHelper *name, uint16_t cycles){
+    Serial.print(name);
+    Serial.print(F(": "));
+    Serial.print(cycles);
+    Serial.println(F(" cycles"));
+}
+
+void setup(){
+
+    Serial.begin(115200);
+    bench_numfmt();
+    bench_pressbutton();
+    bench_lcd();
+
+    //simavr quits when the MCU sleeps with interrupts off
+    Serial.flush();
+    cli();
+    sleep_cpu();
+}
+
+void loop(){}
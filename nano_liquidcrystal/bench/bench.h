@@ -0,0 +1,20 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <Arduino.h>
+
+/* |
+* @brief the benches in bench/, built into one firmware by [env:bench] - bench.cpp runs them one after the
+*        other and sends the results on the serial port
+*/
+
+void bench_lcd();               //LCD characters per second at 100kHz and 400kHz (bench/lcd_cps.cpp)
+void bench_numfmt();            //NumFmt cycles against Print (bench/numfmt_cycles.cpp)
+void bench_pressbutton();       //PressButton read cycles against the classes it replaced (bench/pressbutton_cycles.cpp)
+
+//Timer1 runs at F_CPU, so TCNT1 counts cycles (the measurement itself costs a few) - up to 65535, interrupts off
+void startCycles();
+uint16_t stopCycles();
+void report(const __FlashStringHelper *name, uint16_t cycles);     //sends "name: cycles cycles"
+
+#endif
@@ -0,0 +1,84 @@
+// LCD backend throughput - characters per second at 100kHz and 400kHz, part of [env:bench] (bench/bench.cpp)
+// it times the bus, so it needs the board with the display - without one (in simavr) it is skipped
+#include <Arduino.h>
+#include <TwiQueue.h>
+#include <LcdI2C.h>
+#include "bench.h"
+
+#define BENCH_ROWS 8            //rows of 16 characters written per method
+
+static LcdI2C lcd(0x27, 16, 2);
+static const uint8_t text[16] = {'0','1','2','3','4','5','6','7','8','9','A','B','C','D','E','F'};
+
+//one blocking transaction per expander write plus the enable pulse delays - what LiquidCrystal_I2C does
+static void legacyWrite4bits(uint8_t value){
+    uint8_t b = value | LCDI2C_BL;
+    twiq_write(0x27, &b, 1); twiq_flush();
+    b |= LCDI2C_EN;
+    twiq_write(0x27, &b, 1); twiq_flush();
+    delayMicroseconds(1);
+    b &= ~LCDI2C_EN;
+    twiq_write(0x27, &b, 1); twiq_flush();
+    delayMicroseconds(50);
+}
+static void legacySend(uint8_t value, uint8_t mode){
+    legacyWrite4bits((value & 0xF0) | mode);
+    legacyWrite4bits((uint8_t)(value << 4) | mode);
+}
+
+//characters per second for BENCH_ROWS rows written in the given time
+static uint32_t cps(uint32_t us){return (BENCH_ROWS * 16UL * 1000000UL) / us;}
+
+static void runBench(uint32_t frequency){
+
+    lcd.init(frequency);
+    lcd.backlight();
+    lcd.flush();
+
+    //LiquidCrystal_I2C style - 6 transactions per character
+    uint32_t t = micros();
+    for(uint8_t r = 0; r < BENCH_ROWS; r++){
+        legacySend(0x80 | ((r & 1) ? 0x40 : 0), 0);
+        for(uint8_t i = 0; i < 16; i++){legacySend(text[i], LCDI2C_RS);}
+    }
+    uint32_t legacyUs = micros() - t;
+
+    //one queued transaction per character
+    t = micros();
+    for(uint8_t r = 0; r < BENCH_ROWS; r++){
+        lcd.setCursor(0, r & 1);
+        for(uint8_t i = 0; i < 16; i++){lcd.write(text[i]);}
+    }
+    lcd.flush();
+    uint32_t charUs = micros() - t;
+
+    //one burst per row
+    t = micros();
+    for(uint8_t r = 0; r < BENCH_ROWS; r++){
+        lcd.setCursor(0, r & 1);
+        lcd.write(text, 16);
+    }
+    lcd.flush();
+    uint32_t burstUs = micros() - t;
+
+    Serial.print(frequency);
+    Serial.print(F(" Hz: legacy "));
+    Serial.print(cps(legacyUs));
+    Serial.print(F(" cps, per char "));
+    Serial.print(cps(charUs));
+    Serial.print(F(" cps, burst "));
+    Serial.print(cps(burstUs));
+    Serial.println(F(" cps"));
+}
+
+void bench_lcd(){
+
+    //no expander answering, nothing to time
+    lcd.init(100000);
+    if(twiq_readByte(0x27) < 0){
+        Serial.println(F("LCD: no display at 0x27, skipped"));
+        return;
+    }
+    runBench(100000);
+    runBench(400000);
+}
@@ -0,0 +1,36 @@
+// NumFmt cost in CPU cycles against Print's division based formatting, part of [env:bench] (bench/bench.cpp)
+#include <Arduino.h>
+#include <NumFmt.h>
+#include "bench.h"
+
+//throws the characters away, only used to time Print::print()
+class NullPrint : public Print{
+public:
+    size_t write(uint8_t) override {return 1;}
+    size_t write(const uint8_t *, size_t size) override {return size;}
+};
+
+static NullPrint nullOut;
+static char buf[NUMFMT_U32_DIGITS];
+static volatile uint32_t sink;
+
+void bench_numfmt(){
+
+    noInterrupts();
+
+    startCycles(); sink = numfmt_u8(buf, 199, 3, ' ', false); uint16_t u8c = stopCycles();
+    startCycles(); sink = numfmt_u16(buf, 59999, 5, ' ', false); uint16_t u16c = stopCycles();
+    startCycles(); sink = numfmt_u32(buf, 3999999999UL, 10, ' ', false); uint16_t u32c = stopCycles();
+    startCycles(); sink = nullOut.print(199); uint16_t p8c = stopCycles();
+    startCycles(); sink = nullOut.print(59999U); uint16_t p16c = stopCycles();
+    startCycles(); sink = nullOut.print(3999999999UL); uint16_t p32c = stopCycles();
+
+    interrupts();
+
+    report(F("numfmt_u8  199"), u8c);
+    report(F("numfmt_u16 59999"), u16c);
+    report(F("numfmt_u32 3999999999"), u32c);
+    report(F("print 199"), p8c);
+    report(F("print 59999"), p16c);
+    report(F("print 3999999999"), p32c);
+}
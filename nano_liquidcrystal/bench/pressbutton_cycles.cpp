@@ -0,0 +1,37 @@
+// PressButton read cost in CPU cycles - the template against the runtime pin classes it replaced, part of
+// [env:bench] (bench/bench.cpp)
+#include <Arduino.h>
+#include <PressButton.h>
+#include "bench.h"
+
+static PressButton<A0> btn;
+static volatile uint8_t pin = A0;   //runtime pin, so the compiler cannot fold the old reads
+static volatile uint8_t port, bit;
+static volatile boolean sink;
+
+//IsDown() of the original class: two digitalRead() calls on an int pin
+static boolean __attribute__((noinline)) digitalIsDown(uint8_t p){return digitalRead(p) == LOW && digitalRead(p) == LOW;}
+
+//IsDown() of the bank handle class: an out of line member reading its port and bit from the object
+static boolean __attribute__((noinline)) handleIsDown(uint8_t p, uint8_t b){return bank_down(p) & b;}
+
+void bench_pressbutton(){
+
+    port = bank_port(A0);
+    bit = bank_bit(A0);
+    noInterrupts();
+
+    startCycles(); uint16_t emptyc = stopCycles();
+    startCycles(); sink = digitalIsDown(pin); uint16_t digc = stopCycles();
+    startCycles(); sink = handleIsDown(port, bit); uint16_t handc = stopCycles();
+    startCycles(); sink = btn.IsDown(); uint16_t tmplc = stopCycles();
+    startCycles(); sink = btn.CaptureDownState(); uint16_t capc = stopCycles();
+
+    interrupts();
+
+    report(F("empty measurement"), emptyc);
+    report(F("digitalRead x2 IsDown"), digc);
+    report(F("bank handle IsDown"), handc);
+    report(F("template IsDown"), tmplc);
+    report(F("template CaptureDownState"), capc);
+}
@@ -0,0 +1,92 @@
+#ifndef MENU_H
+#define MENU_H
+
+#include <Arduino.h>
+
+/* |
+* @brief menu descriptors - pages and their items live in flash and are all run by the
+*        one generic page loop in main.cpp. Item counts are derived from the item arrays and
+*        the page links are checked against the parent pages at compile time (MENU_CHECK).
+*        Labels and titles must be PROGMEM char arrays, their lengths are taken with sizeof so
+*        nothing is measured or copied at runtime
+*/
+
+enum menuItemKind{
+        MI_TEXT,                //label only
+        MI_PAGE,                //OK opens the child page
+        MI_BACK,                //OK returns to the parent page
+        MI_ACTION,              //OK calls the action
+        MI_BOOL,                //+/- toggles the bound boolean
+        MI_UINT8                //+/- adjusts the bound uint8_t between min and max
+};
+
+struct RepeatProfile;            //auto repeat profile, see PressButton
+
+struct MenuItem{
+        const char *label;      //PROGMEM label
+        uint8_t labelLen;       //label length, taken from the label array at compile time
+        uint8_t kind;           //one of menuItemKind
+        uint8_t page;           //child page (MI_PAGE)
+        void *value;            //bound value (MI_BOOL, MI_UINT8)
+        uint8_t min;            //lowest value (MI_UINT8)
+        uint8_t max;            //highest value (MI_UINT8)
+        void (*action)();       //called on OK (MI_ACTION)
+        const RepeatProfile *repeat;    //PROGMEM auto repeat profile of +/- (MI_UINT8), nullptr for the default
+};
+
+struct MenuPage{
+        uint8_t id;             //page id, must be the position of the page in the page table
+        const char *title;      //PROGMEM title
+        uint8_t titleLen;       //title length, set with MENU_TITLE()
+        const MenuItem *items;  //PROGMEM items
+        uint8_t itemCount;      //number of items, set with MENU_ITEMS()
+        uint8_t parent;         //page the back button returns to
+        void (*onEnter)();      //called once when the page is opened
+        void (*onLoop)();       //called on every loop iteration
+        void (*onLeave)();      //called once when the page is left
+};
+
+// ITEM AND PAGE HELPERS ---------------------------------------------------------------------
+
+//lets Print stream a PROGMEM label or title (the AVR core only has F() for literals)
+#ifndef FPSTR
+#define FPSTR(p)                                (reinterpret_cast<const __FlashStringHelper *>(p))
+#endif
+
+#define MENU_LEN(text)                          (uint8_t)(sizeof(text) - 1)
+#define MENU_TITLE(title)                       title, MENU_LEN(title)
+
+#define MENU_TEXT(label)                        {label, MENU_LEN(label), MI_TEXT, 0, nullptr, 0, 0, nullptr, nullptr}
+#define MENU_LINK(label, page)                  {label, MENU_LEN(label), MI_PAGE, page, nullptr, 0, 0, nullptr, nullptr}
+#define MENU_BACK(label)                        {label, MENU_LEN(label), MI_BACK, 0, nullptr, 0, 0, nullptr, nullptr}
+#define MENU_ACTION(label, fn)                  {label, MENU_LEN(label), MI_ACTION, 0, nullptr, 0, 0, fn, nullptr}
+#define MENU_BOOL(label, var)                   {label, MENU_LEN(label), MI_BOOL, 0, &(var), 0, 1, nullptr, nullptr}
+#define MENU_UINT8(label, var, min, max)        {label, MENU_LEN(label), MI_UINT8, 0, &(var), min, max, nullptr, nullptr}
+#define MENU_UINT8_FAST(label, var, min, max, profile) \
+                                                {label, MENU_LEN(label), MI_UINT8, 0, &(var), min, max, nullptr, &(profile)}
+
+#define MENU_ITEMS(items)                       items, (uint8_t)(sizeof(items) / sizeof(items[0]))
+#define MENU_NO_ITEMS                           nullptr, 0
+
+// COMPILE TIME CHECKS ----------------------------------------------------------------------
+
+//true when every link from the items of page p onwards opens a page whose parent is p
+constexpr bool menuItemsLinked(const MenuPage *pages, uint8_t pageCnt, uint8_t p, uint8_t i){
+        return i >= pages[p].itemCount ? true :
+                ((pages[p].items[i].kind != MI_PAGE ||
+                        (pages[p].items[i].page < pageCnt && pages[pages[p].items[i].page].parent == p)) &&
+                 menuItemsLinked(pages, pageCnt, p, i + 1));
+}
+
+//true when page p onwards sit at their own id, have a valid parent and consistent links
+constexpr bool menuPagesLinked(const MenuPage *pages, uint8_t pageCnt, uint8_t p){
+        return p >= pageCnt ? true :
+                (pages[p].id == p && pages[p].parent < pageCnt &&
+                 menuItemsLinked(pages, pageCnt, p, 0) && menuPagesLinked(pages, pageCnt, p + 1));
+}
+
+#define MENU_CHECK(pages, pageCnt) \
+        static_assert(sizeof(pages) / sizeof(pages[0]) == pageCnt, "page table does not match the page list"); \
+        static_assert(menuPagesLinked(pages, pageCnt, 0), "menu page ids, parents or links are inconsistent")
+
+#endif
@@ -0,0 +1,144 @@
+#include "ButtonBank.h"
+#include <avr/interrupt.h>
+#include <util/atomic.h>
+
+static uint8_t _Mask[BANK_PORTS];               //registered bits of each port
+static uint8_t _Ct0[BANK_PORTS] = {0xFF, 0xFF, 0xFF};   //vertical counter, low bit of every pin (starts at 11)
+static uint8_t _Ct1[BANK_PORTS] = {0xFF, 0xFF, 0xFF};   //vertical counter, high bit of every pin
+static uint8_t _Div;                            //ticks until the next sample
+
+static uint8_t _Slots;                          //pins registered
+static uint8_t _SlotPort[BANK_PINS];            //bank port of each slot
+static uint8_t _SlotBit[BANK_PINS];             //bit of each slot
+static volatile uint8_t _Edge[BANK_PORTS];      //bits with a timestamped edge not debounced yet
+static volatile uint16_t _EdgeMs[BANK_PINS];    //time of that edge per slot
+
+static BankEvent _Ev[BANK_EVENTS];              //event queue
+static volatile uint8_t _EvTail;                //next event to take
+
+volatile uint8_t bank_downBits[BANK_PORTS];
+volatile uint8_t bank_events;                   //also the write index of the queue
+
+//queues an event for every slot of the flipped bits (interrupts are off, this runs in the sampling)
+static void queue(uint8_t p, uint8_t flipped, uint8_t down){
+
+    uint16_t now = millis();
+    for(uint8_t s = 0; s < _Slots; s++){
+
+        uint8_t bit = _SlotBit[s];
+        if(_SlotPort[s] != p || !(flipped & bit)){continue;}
+
+        //full, the event is dropped
+        if((uint8_t)(bank_events - _EvTail) == BANK_EVENTS){continue;}
+
+        BankEvent *e = &_Ev[bank_events & (BANK_EVENTS - 1)];
+        e->code = s | ((down & bit) ? BANK_DOWN : 0);
+        e->ms = (_Edge[p] & bit) ? _EdgeMs[s] : now;
+        bank_events++;
+    }
+    _Edge[p] &= ~flipped;
+}
+
+//one debounce step of a port, every bit in parallel - a bit that differs from its state counts
+//its counter down (11 > 10 > 01 > 00) and flips on the 4th sample, an equal bit resets it to 11
+static inline void sample(uint8_t p, uint8_t pin){
+
+    uint8_t down = bank_downBits[p];
+    uint8_t i = (down ^ ~pin) & _Mask[p];
+    uint8_t ct0 = ~(_Ct0[p] & i);
+    uint8_t ct1 = ct0 ^ (_Ct1[p] & i);
+    _Ct0[p] = ct0;
+    _Ct1[p] = ct1;
+
+    //a bit back at its state was a glitch, its edge time is stale
+    _Edge[p] &= i;
+
+    i &= ct0 & ct1;
+    if(i){
+        down ^= i;
+        bank_downBits[p] = down;
+        queue(p, i, down);
+    }
+}
+
+//Timer0 compares once per overflow, so this runs every 1.024ms next to the millis tick
+ISR(TIMER0_COMPB_vect){
+
+    if(--_Div){return;}
+    _Div = BANK_TICK_DIV;
+
+    sample(0, PINB);
+    sample(1, PINC);
+    sample(2, PIND);
+}
+
+//stamps the first edge of every registered pin of the port that now differs from its debounced state
+static inline void edge(uint8_t p, uint8_t pin){
+
+    uint8_t bits = (bank_downBits[p] ^ ~pin) & _Mask[p] & ~_Edge[p];
+    if(!bits){return;}
+
+    uint16_t now = millis();
+    for(uint8_t s = 0; s < _Slots; s++){
+        if(_SlotPort[s] == p && (bits & _SlotBit[s])){_EdgeMs[s] = now;}
+    }
+    _Edge[p] |= bits;
+}
+
+ISR(PCINT0_vect){edge(0, PINB);}
+ISR(PCINT1_vect){edge(1, PINC);}
+ISR(PCINT2_vect){edge(2, PIND);}
+
+//registers a button pin, starts the sampling and its pin change interrupt, returns the slot of the pin
+uint8_t bank_add(uint8_t pin){
+
+    uint8_t p = digitalPinToPort(pin) - PB;
+    uint8_t bit = digitalPinToBitMask(pin);
+
+    //a pin registered before keeps its slot
+    for(uint8_t s = 0; s < _Slots; s++){
+        if(_SlotPort[s] == p && _SlotBit[s] == bit){return s;}
+    }
+    if(_Slots == BANK_PINS){return BANK_PINS - 1;}
+
+    pinMode(pin, INPUT_PULLUP);
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+        //a button held at start up is down already, it is not a press
+        if(!(*portInputRegister(digitalPinToPort(pin)) & bit)){bank_downBits[p] |= bit;}
+        _Mask[p] |= bit;
+        _SlotPort[_Slots] = p;
+        _SlotBit[_Slots] = bit;
+        _Slots++;
+
+        *digitalPinToPCMSK(pin) |= _BV(digitalPinToPCMSKbit(pin));
+        PCICR |= _BV(digitalPinToPCICRbit(pin));
+
+        if(!(TIMSK0 & _BV(OCIE0B))){
+            _Div = BANK_TICK_DIV;
+            OCR0B = 0x80;
+            TIMSK0 |= _BV(OCIE0B);
+        }
+    }
+    return _Slots - 1;
+}
+
+//oldest queued event, false when there is none
+bool bank_takeEvent(BankEvent *e){
+
+    bool any = false;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+        if(_EvTail != bank_events){
+            *e = _Ev[_EvTail & (BANK_EVENTS - 1)];
+            _EvTail++;
+            any = true;
+        }
+    }
+    return any;
+}
+
+//bank port of a registered slot
+uint8_t bank_slotPort(uint8_t slot){return _SlotPort[slot];}
+
+//bit of a registered slot
+uint8_t bank_slotBit(uint8_t slot){return _SlotBit[slot];}
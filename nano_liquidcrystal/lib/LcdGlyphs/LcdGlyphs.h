@@ -0,0 +1,38 @@
+#ifndef LCDGLYPHS_H
+#define LCDGLYPHS_H
+
+#include <Arduino.h>
+#include <LcdShadow.h>
+
+#define LCDGLYPHS_SLOTS 8       //custom character slots of the HD44780 CGRAM
+#define LCDGLYPHS_NONE 0xFF     //slot holds no known glyph
+
+/* |
+* @brief CGRAM slot manager - the glyph bitmaps stay in a PROGMEM table and are only uploaded when
+*        a page asks for them. Tracks which glyph sits in each slot, uploads the missing ones of a
+*        page in one burst per run of slots and evicts the least recently used slots when needed.
+*        Evicting a slot changes every cell showing it, so load a page's glyphs before drawing the page.
+*/
+
+class LcdGlyphs {
+
+private:
+
+    LcdShadow &_Lcd;                            //display the glyphs are uploaded to
+    const uint8_t (*_Table)[8];                 //PROGMEM glyph bitmaps, indexed by glyph id
+    uint8_t _Slot[LCDGLYPHS_SLOTS];             //glyph in each slot, LCDGLYPHS_NONE when unknown
+    uint8_t _Order[LCDGLYPHS_SLOTS];            //slots from most to least recently used
+
+    int8_t find(uint8_t glyph);                 //slot holding the glyph, -1 if not loaded
+    void touch(uint8_t slot);                   //marks the slot as most recently used
+
+public:
+
+    LcdGlyphs(LcdShadow &lcd, const uint8_t (*table)[8]);   //Initializer. Requires the display and the PROGMEM glyph table
+    void reset();                               //forgets the slot contents (call after the display is initialized again)
+    void load(const uint8_t *glyphs, uint8_t count);    //makes sure the glyphs are loaded, the missing ones are uploaded in one go
+    uint8_t code(uint8_t glyph);                //character code to print the glyph with, loads it if needed
+
+};
+
+#endif
@@ -0,0 +1,174 @@
+#include "LcdI2C.h"
+
+//HD44780 commands
+#define LCD_CLEARDISPLAY 0x01
+#define LCD_RETURNHOME 0x02
+#define LCD_ENTRYMODESET 0x04
+#define LCD_DISPLAYCONTROL 0x08
+#define LCD_FUNCTIONSET 0x20
+#define LCD_SETCGRAMADDR 0x40
+#define LCD_SETDDRAMADDR 0x80
+
+//command flags
+#define LCD_ENTRYLEFT 0x02
+#define LCD_DISPLAYON 0x04
+#define LCD_2LINE 0x08
+#define LCD_4BITMODE 0x00
+
+#define LCD_SLOW_CMD_US 2000    //worst case execution time of clear and home, also the busy flag poll timeout
+
+//Initializer. Required the I2C address and display size
+LcdI2C::LcdI2C(uint8_t addr, uint8_t cols, uint8_t rows){
+    _Addr = addr;
+    _Rows = rows;
+    _Backlight = 0;
+    _DisplayControl = LCD_DISPLAYON;
+    _BusyFlag = false;
+}
+
+//sets the expander outputs right away (used by the init sequence)
+void LcdI2C::expanderWrite(uint8_t data){
+    data |= _Backlight;
+    twiq_write(_Addr, &data, 1);
+    twiq_flush();
+}
+
+//queues command or data bytes as one strobed nibble burst - the TWI interrupt expands each byte into
+//6 expander writes. The PCF8574 latches every byte as it is acknowledged, so the enable edges come out inline
+//and the 3 expander bytes between two falling edges (67us at 400kHz) cover the enable pulse and the 37us execution time
+void LcdI2C::send(const uint8_t *buffer, uint8_t size, uint8_t mode){
+    twiq_beginNibbles(_Addr, mode | _Backlight, LCDI2C_EN);
+    for(uint8_t i = 0; i < size; i++){twiq_put(buffer[i]);}
+    twiq_end();
+}
+
+//starts the bus and runs the 4 bit init sequence (blocking)
+void LcdI2C::init(uint32_t frequency){
+
+    twiq_init(frequency);
+
+    //wait for the display to power up with all the control lines low
+    delay(50);
+    expanderWrite(0);
+
+    //three times function set 8 bit, then switch to 4 bit (HD44780 datasheet figure 24)
+    for(uint8_t i = 0; i < 3; i++){
+        expanderWrite(0x30);
+        expanderWrite(0x30 | LCDI2C_EN);
+        expanderWrite(0x30);
+        delayMicroseconds(4500);
+    }
+    expanderWrite(0x20);
+    expanderWrite(0x20 | LCDI2C_EN);
+    expanderWrite(0x20);
+
+    command(LCD_FUNCTIONSET | LCD_4BITMODE | (_Rows > 1 ? LCD_2LINE : 0));
+    command(LCD_DISPLAYCONTROL | _DisplayControl);
+    command(LCD_ENTRYMODESET | LCD_ENTRYLEFT);
+
+    //first clear on the fixed delay, after that the display is idle and must report not busy.
+    //A flag stuck high means R/W is tied low - the probe was then taken as a write, so clear again
+    _BusyFlag = false;
+    clear();
+    int8_t busy = readBusyFlag();
+    if(busy == 0){_BusyFlag = true;}
+    else{clear();}
+}
+
+//reads the busy flag (blocking), -1 if the expander did not answer.
+//R/W high with the data lines released, the flag is on D7 while enable is high for the first nibble,
+//then a second enable pulse clocks out the low nibble to finish the 4 bit read
+int8_t LcdI2C::readBusyFlag(){
+    uint8_t rd = 0xF0 | LCDI2C_RW | _Backlight;
+    uint8_t first[2] = {rd, (uint8_t)(rd | LCDI2C_EN)};
+    uint8_t second[3] = {rd, (uint8_t)(rd | LCDI2C_EN), rd};
+
+    twiq_write(_Addr, first, 2);
+    int16_t pins = twiq_readByte(_Addr);
+    twiq_write(_Addr, second, 3);
+
+    if(pins < 0){return -1;}
+    return (pins & 0x80) ? 1 : 0;
+}
+
+//waits for a slow command to finish - polls the busy flag when it can be read, fixed worst case delay otherwise
+void LcdI2C::waitReady(){
+
+    if(_BusyFlag){
+        uint32_t startUs = micros();
+        while(micros() - startUs < LCD_SLOW_CMD_US){
+            int8_t busy = readBusyFlag();
+            if(busy == 0){return;}
+            if(busy < 0){break;}
+        }
+
+        //flag stuck or expander gone -> stay on fixed delays from now on
+        _BusyFlag = false;
+    }
+    delayMicroseconds(LCD_SLOW_CMD_US);
+}
+
+//true when slow commands poll the busy flag instead of a fixed delay
+bool LcdI2C::hasBusyFlag(){return _BusyFlag;}
+
+//clears the display (waits for the display to finish)
+void LcdI2C::clear(){command(LCD_CLEARDISPLAY); flush(); waitReady();}
+
+//moves the cursor home (waits for the display to finish)
+void LcdI2C::home(){command(LCD_RETURNHOME); flush(); waitReady();}
+
+//switches the display on
+void LcdI2C::display(){_DisplayControl |= LCD_DISPLAYON; command(LCD_DISPLAYCONTROL | _DisplayControl);}
+
+//switches the display off, contents are kept
+void LcdI2C::noDisplay(){_DisplayControl &= ~LCD_DISPLAYON; command(LCD_DISPLAYCONTROL | _DisplayControl);}
+
+//switches the backlight on
+void LcdI2C::backlight(){_Backlight = LCDI2C_BL; twiq_write(_Addr, &_Backlight, 1);}
+
+//switches the backlight off
+void LcdI2C::noBacklight(){_Backlight = 0; twiq_write(_Addr, &_Backlight, 1);}
+
+//sets the position of the next write - rows past the last one land in the hidden part of DDRAM like LiquidCrystal_I2C
+void LcdI2C::setCursor(uint8_t col, uint8_t row){
+    static const uint8_t rowOffsets[] = {0x00, 0x40, 0x14, 0x54};
+    if(row > 3){row = 3;}
+    command(LCD_SETDDRAMADDR | (col + rowOffsets[row]));
+}
+
+//loads a custom character into CGRAM - the display address is left in CGRAM, so set the cursor afterwards
+void LcdI2C::createChar(uint8_t location, uint8_t charmap[]){
+    command(LCD_SETCGRAMADDR | ((location & 0x7) << 3));
+    write(charmap, 8);
+}
+
+//loads the characters table[glyphs[0..count-1]] from flash into the slots from location on -
+//the CGRAM address auto increments, so the bitmaps follow the address command as one data burst
+void LcdI2C::createChars_P(uint8_t location, const uint8_t (*table)[8], const uint8_t *glyphs, uint8_t count){
+    command(LCD_SETCGRAMADDR | ((location & 0x7) << 3));
+    twiq_beginNibbles(_Addr, LCDI2C_RS | _Backlight, LCDI2C_EN);
+    for(uint8_t i = 0; i < count; i++){
+        for(uint8_t r = 0; r < 8; r++){twiq_put(pgm_read_byte(&table[glyphs[i]][r]));}
+    }
+    twiq_end();
+}
+
+//queues a raw command byte
+void LcdI2C::command(uint8_t value){send(&value, 1, 0);}
+
+//queues a single character
+size_t LcdI2C::write(uint8_t value){send(&value, 1, LCDI2C_RS); return 1;}
+
+//queues a run of characters as a single burst (split by the queue only past its transaction limit)
+size_t LcdI2C::write(const uint8_t *buffer, size_t size){
+    size_t left = size;
+    while(left > 0){
+        uint8_t cnt = left > 0xFF ? 0xFF : left;
+        send(buffer, cnt, LCDI2C_RS);
+        buffer += cnt; left -= cnt;
+    }
+    return size;
+}
+
+//waits until everything queued has reached the display
+void LcdI2C::flush(){twiq_flush();}
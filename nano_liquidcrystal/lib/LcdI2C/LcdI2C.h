@@ -0,0 +1,61 @@
+#ifndef LCDI2C_H
+#define LCDI2C_H
+
+#include <Arduino.h>
+#include <TwiQueue.h>
+
+#define LCDI2C_FREQ 100000      //default I2C clock for the PCF8574 backpack
+
+//PCF8574 pin mapping of the common backpacks
+#define LCDI2C_RS 0x01          //register select
+#define LCDI2C_RW 0x02          //read / write
+#define LCDI2C_EN 0x04          //enable strobe
+#define LCDI2C_BL 0x08          //backlight
+
+/* |
+* @brief HD44780 display on a PCF8574 I2C backpack, drop in for the LiquidCrystal_I2C calls used by the menus.
+*        Everything goes out through the TWI queue so the calls return before the display is written.
+*        A run of characters is one I2C transaction with the enable edges inline (6 expander bytes per character)
+*        where LiquidCrystal_I2C starts a new transaction for each of those 6 bytes.
+*        Slow commands (clear/home) poll the busy flag when R/W is wired to the expander, detected at init,
+*        and fall back to the fixed worst case delay on modules with R/W tied low.
+*/
+
+class LcdI2C : public Print {
+
+private:
+
+    uint8_t _Addr;              //I2C address of the backpack
+    uint8_t _Rows;              //number of display rows
+    uint8_t _Backlight;         //backlight bit added to every expander write
+    uint8_t _DisplayControl;    //last display on/off control value sent
+    bool _BusyFlag;             //true when the busy flag can be read back (R/W wired)
+
+    void expanderWrite(uint8_t data);           //sets the expander outputs right away (used by the init sequence)
+    void send(const uint8_t *buffer, uint8_t size, uint8_t mode);   //queues command or data bytes as one strobed nibble burst
+    int8_t readBusyFlag();                      //reads the busy flag (blocking), -1 if the expander did not answer
+    void waitReady();                           //waits for a slow command to finish
+
+public:
+
+    LcdI2C(uint8_t addr, uint8_t cols, uint8_t rows);   //Initializer. Required the I2C address and display size
+    void init(uint32_t frequency = LCDI2C_FREQ);    //starts the bus and runs the 4 bit init sequence (blocking)
+    void clear();                               //clears the display (waits for the display to finish)
+    void home();                                //moves the cursor home (waits for the display to finish)
+    void display();                             //switches the display on
+    void noDisplay();                           //switches the display off, contents are kept
+    void backlight();                           //switches the backlight on
+    void noBacklight();                         //switches the backlight off
+    void setCursor(uint8_t col, uint8_t row);   //sets the position of the next write
+    void createChar(uint8_t location, uint8_t charmap[]);   //loads a custom character into CGRAM
+    void createChars_P(uint8_t location, const uint8_t (*table)[8], const uint8_t *glyphs, uint8_t count);  //loads PROGMEM characters into consecutive CGRAM slots as one burst
+    void command(uint8_t value);                //queues a raw command byte
+    virtual size_t write(uint8_t value);        //queues a single character
+    virtual size_t write(const uint8_t *buffer, size_t size);   //queues a run of characters as a single burst
+    using Print::write;
+    void flush();                               //waits until everything queued has reached the display
+    bool hasBusyFlag();                         //true when slow commands poll the busy flag instead of a fixed delay
+
+};
+
+#endif
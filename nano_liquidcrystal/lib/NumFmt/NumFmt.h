@@ -0,0 +1,23 @@
+#ifndef NUMFMT_H
+#define NUMFMT_H
+
+#include <Arduino.h>
+
+#define NUMFMT_U32_DIGITS 10    //most digits a uint32_t can have
+
+/* |
+* @brief division free unsigned integer formatting - the digits are found by subtracting
+*        powers of ten (32 bit only for the top places, 16 bit for the last four) and padded
+*        out to a fixed width field so the whole field can be sent with one write.
+*        The buffer must hold the larger of width and the digit count, nothing is terminated.
+*
+*        Worst case cost at 16MHz (all nines, estimated from the generated loop - bench/numfmt_cycles.cpp
+*        measures it, pio run -e bench -t upload): uint8 ~110, uint16 ~330, uint32 ~1100 cycles.
+*        Print::print() of the same uint32 does ten 32 bit divisions, around 6000 cycles.
+*/
+
+uint8_t numfmt_u8(char *buf, uint8_t value, uint8_t width, char fill, bool isRight);     //formats the value into buf, returns the field length
+uint8_t numfmt_u16(char *buf, uint16_t value, uint8_t width, char fill, bool isRight);   //same for a uint16_t
+uint8_t numfmt_u32(char *buf, uint32_t value, uint8_t width, char fill, bool isRight);   //same for a uint32_t
+
+#endif
@@ -0,0 +1,49 @@
+#include "Power.h"
+#include <ButtonBank.h>
+#include <avr/sleep.h>
+#include <avr/interrupt.h>
+
+//the pin change vectors are the button bank's, its edge stamping is what wakes the MCU up
+
+//sleeps until the next interrupt - PWR_AWAKE builds keep the CPU running, to measure the current against
+void pwr_idle(){
+#ifndef PWR_AWAKE
+    set_sleep_mode(SLEEP_MODE_IDLE);
+    sleep_mode();
+#endif
+}
+
+//powers down until one of the pins changes, ADC off meanwhile
+void pwr_powerDown(const uint8_t *pins, uint8_t count){
+
+    //the pin change interrupts of the wake pins, any flag still set from before is dropped
+    uint8_t pcicr = PCICR, pcmsk0 = PCMSK0, pcmsk1 = PCMSK1, pcmsk2 = PCMSK2;
+    for(uint8_t i = 0; i < count; i++){
+        *digitalPinToPCMSK(pins[i]) |= _BV(digitalPinToPCMSKbit(pins[i]));
+        PCICR |= _BV(digitalPinToPCICRbit(pins[i]));
+    }
+    PCIFR = _BV(PCIF0) | _BV(PCIF1) | _BV(PCIF2);
+
+    //the ADC draws current even when idle
+    uint8_t adcsra = ADCSRA;
+    ADCSRA = 0;
+
+    //a pin already low would never change again, so only sleep when all are high -
+    //sleep_cpu right after sei runs before any interrupt, so a press after the check still wakes
+    set_sleep_mode(SLEEP_MODE_PWR_DOWN);
+    cli();
+    bool allHigh = true;
+    for(uint8_t i = 0; i < count; i++){if(digitalRead(pins[i]) == LOW){allHigh = false;}}
+    if(allHigh){
+        sleep_enable();
+        sei();
+        sleep_cpu();
+        sleep_disable();
+    }
+    sei();
+
+    //back to where we were
+    ADCSRA = adcsra;
+    PCMSK0 = pcmsk0; PCMSK1 = pcmsk1; PCMSK2 = pcmsk2;
+    PCICR = pcicr;
+}
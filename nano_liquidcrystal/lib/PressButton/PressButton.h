@@ -1,29 +1,89 @@
 #include <Arduino.h>
+#include <ButtonBank.h>
+
+#define PRESSBUTTON_MAX 8       //most buttons that can be created
+#define REPEAT_STAGES 8         //most stages in a repeat profile
+
+//one auto repeat stage - the wait since the previous trigger and the step the trigger is worth
+struct RepeatStage{
+    uint16_t intervalMs;        //time since the previous trigger (ignored for the first trigger, it is immediate)
+    uint16_t step;              //step size returned by Repeated(profile) for this trigger
+};
+
+//auto repeat acceleration profile, kept in PROGMEM - trigger n uses stage n, the last stage repeats for as long as the button is held
+struct RepeatProfile{
+    uint8_t count;                          //stages in use
+    RepeatStage stages[REPEAT_STAGES];
+};
+
+extern const RepeatProfile repeatDefault PROGMEM;      //450ms, then 50ms faster per trigger down to 200ms, step 1 (the original timing)
+extern const RepeatProfile repeatFast8 PROGMEM;        //sweeps 0-255 in about 2.3s with the menu pacing
+extern const RepeatProfile repeatFast16 PROGMEM;       //sweeps 0-65535 in about 2.5s with the menu pacing
 
 /* |
-* @brief function and debounce button  
+* @brief function and debounce button - the button state comes from the ButtonBank samples. The pin is a
+*        template parameter, so its bank port and bit are constants and IsDown()/IsUp()/CaptureDownState()
+*        inline to a load and a bit test, no pin table lookup and no call. The was down flags and the
+*        repeat state are packed per bank port or per button in the PressButtonBase tables, a button
+*        only holds its table index. Dispatch() takes the bank events in order and hands the presses
+*        to the buttons, the repeat timing of a press starts at its edge rather than at the next poll
 */
 
-class PressButton {
+class PressButtonBase {
+
+protected:
+
+    uint8_t _Idx;                   //Internal value - index in the repeat tables
+    static uint8_t _Cnt;                            //buttons created
+    static uint8_t _WasDown[BANK_PORTS];            //was down flags, one bit per pin as set by CaptureDownState()
+    static uint8_t _RepeatCnt[PRESSBUTTON_MAX];     //number of times repeat trigger sent
+    static uint16_t _LasRepeatMs[PRESSBUTTON_MAX];  //when the last repeat trigger was sent (or the press edge before the first), low 16 bits of millis()
+    static uint8_t _Stamped[BANK_PORTS];            //presses whose edge time is in _LasRepeatMs, one bit per pin
+    static uint8_t _IdxOf[BANK_PINS];               //table index of each bank slot
+
+    PressButtonBase(uint8_t pin);                   //registers the pin with the bank and takes a table index
+    uint16_t repeated(uint8_t port, uint8_t bit, const RepeatProfile *profile);    //Repeated() of the button on that port bit
+
+public:
+
+    uint8_t RepeatCnt();        //number of times repeat trigger sent since the press, 0 when not repeating
+    static boolean Dispatch();  //takes the bank events in order and sets WasDown of every button pressed since the last call, returns true if there was any press
+
+};
 
-private: 
+template<uint8_t Pin>
+class PressButton : public PressButtonBase {
 
-    int _IoPin;                //Internal value - IO Pin 
+    static_assert(Pin <= 19, "PressButton pin must be D0-D13 or A0-A5");
 
 public:
 
-    PressButton(int pin);       //Initializer for button. Required the pin value
-    int GetIOPin();             //returns the IO pin the button is configured to use
-    boolean WasDown = false;    //store was down states as set by CaptureDownState()
-    uint32_t RepeatCnt = 0;     //maintains a count number of times repeat trigger sent
-    uint32_t LasRepeatMs = 0;   //keeps a records of when last repeatr trigger was sent
-    boolean IsDown();           //does a debounced check to see if the specified button is in the down state
-    boolean IsUp();             //does debounced check to see if specified button is in the up state
-    boolean CaptureDownState(); // will set the WasDown dflag true if was pressed when checked - also returns WasDown
-    boolean CleasWasDown();     //clears the was down state, returns true if clear was done
-    boolean PressReleased();    //provides a trigger action if the button was pressed but is now released > Clears WasDown
-    boolean LongPressed();      //provides trigger for long press case
-    boolean Repeated();         //Provides and action trigger at a increasingly higher frequency for as long as a key is pressed
+    PressButton() : PressButtonBase(Pin){}  //Initializer for button, the pin is the template parameter
+    int GetIOPin(){return Pin;}             //returns the IO pin the button is configured to use
+
+    //returns the debounced down state of the button (sampled by the bank, no pin read)
+    boolean IsDown(){return bank_down(bank_port(Pin)) & bank_bit(Pin);}
+
+    //returns the debounced up state of the button
+    boolean IsUp(){return !(bank_down(bank_port(Pin)) & bank_bit(Pin));}
+
+    // will set the WasDown dflag true if was pressed when checked - also returns WasDown
+    boolean CaptureDownState(){if(IsDown()){_WasDown[bank_port(Pin)] |= bank_bit(Pin);} return _WasDown[bank_port(Pin)] & bank_bit(Pin);}
+
+    //clears the was down state, returns true if clear was done
+    boolean CleasWasDown(){if(_WasDown[bank_port(Pin)] & bank_bit(Pin)){_WasDown[bank_port(Pin)] &= ~bank_bit(Pin); return true;} return false;}
+
+    //provides a trigger action if the button was pressed but is now released > Clears WasDown
+    boolean PressReleased(){if((_WasDown[bank_port(Pin)] & bank_bit(Pin)) && IsUp()){_RepeatCnt[_Idx] = 0; _WasDown[bank_port(Pin)] &= ~bank_bit(Pin); return true;} return false;}
+
+    //provides trigger for long press case
+    boolean LongPressed(){return(Repeated() && _RepeatCnt[_Idx] == 2);}
+
+    //Provides and action trigger at a increasingly higher frequency for as long as a key is pressed
+    boolean Repeated(){return repeated(bank_port(Pin), bank_bit(Pin), &repeatDefault) != 0;}
+
+    //Repeated() following a PROGMEM acceleration profile, returns the step size of the trigger or 0 when there is none
+    uint16_t Repeated(const RepeatProfile *profile){return repeated(bank_port(Pin), bank_bit(Pin), profile);}
 
 };
 
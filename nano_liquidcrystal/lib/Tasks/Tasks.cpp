@@ -0,0 +1,30 @@
+#include "Tasks.h"
+
+//one pass over the table, starts every task that is due (16 bit times, wrap safe up to 65s periods)
+void tasks_run(Task *tasks, uint8_t count){
+
+    for(uint8_t i = 0; i < count; i++){
+
+        Task *t = &tasks[i];
+        uint16_t now = millis();
+        uint16_t since = now - t->lastMs;
+        if(since < t->periodMs){continue;}
+
+        //how late the start is, only meaningful for periodic tasks
+        if(t->periodMs > 0 && since - t->periodMs > t->maxLateMs){t->maxLateMs = since - t->periodMs;}
+        t->lastMs = now;
+
+        uint16_t start = micros();
+        t->run();
+        t->costUs = (uint16_t)micros() - start;
+        if(t->costUs > t->maxCostUs){t->maxCostUs = t->costUs;}
+    }
+}
+
+//worst start delay of a due task - it can just have missed its turn, so one pass over every task plus the millis resolution
+uint32_t tasks_latencyBoundUs(const Task *tasks, uint8_t count){
+
+    uint32_t bound = 1000;
+    for(uint8_t i = 0; i < count; i++){bound += tasks[i].maxCostUs;}
+    return bound;
+}
@@ -0,0 +1,20 @@
+# Post build check: fails the build when the firmware links the heap allocator.
+# The menu firmware must run without malloc so its RAM use is fixed at link time.
+import subprocess
+import sys
+
+Import("env")
+
+HEAP_SYMBOLS = ("malloc", "calloc", "realloc", "free")
+
+
+def check_no_heap(source, target, env):
+    elf = str(target[0])
+    out = subprocess.check_output(["avr-nm", "--defined-only", elf], env=env["ENV"]).decode()
+    found = sorted({line.split()[-1] for line in out.splitlines() if line.split()[-1] in HEAP_SYMBOLS})
+    if found:
+        sys.stderr.write("no_heap: %s links %s, something in the firmware uses the heap\n" % (elf, ", ".join(found)))
+        env.Exit(1)
+
+
+env.AddPostAction("$BUILD_DIR/${PROGNAME}.elf", check_no_heap)
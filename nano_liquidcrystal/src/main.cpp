@@ -1,14 +1,25 @@
 #include <Arduino.h>
-#include <Wire.h>
-#include <LiquidCrystal_I2C.h>
 #include <EEPROM.h>
 #include <PressButton.h>
+#include <LcdI2C.h>
+#include <LcdShadow.h>
+#include <LcdGlyphs.h>
+#include <NumFmt.h>
+#include <Menu.h>
+#include <Tasks.h>
+#include <Power.h>
 
 #define DISP_ITEM_ROWS 2        //number of rows usable in the display(depends on display size)
 #define DISP_CHAR_WIDTH 16      //general info about the hiw many characters in single rows
 #define PACING_MS 25            //minimum wait milisecond between executing code in menu loop
 #define FLASH_RST_CNT 30        //number of loops between switching flash state
 #define SETTING_CHKVAL 3647     //value used to manage versioning control
+#define MENU_VALUE_COL 13       //column where the bound values of the menu items are printed
+#ifdef PWR_AWAKE
+#define SLEEP_AFTER_MS 0UL      //never sleeps, see Power.h
+#else
+#define SLEEP_AFTER_MS 60000UL  //time without a button press before the display goes off and the MCU powers down, 0 = never
+#endif
 
 // ===========================================================
 // ||                   DECLARATIONS                        ||
@@ -23,12 +34,13 @@ const int BTN_PLUS = 6;
 const int BTN_MINUS = 7;
 
 //BUTTONS --------------------------------------------------------------------------
-PressButton btnOk(BTN_OK);
-PressButton btnBack(BTN_BACK);
-PressButton btnUp(BTN_UP);
-PressButton btnDown(BTN_DOWN);
-PressButton btnPlus(BTN_PLUS);
-PressButton btnMinus(BTN_MINUS);
+PressButton<BTN_OK> btnOk;
+PressButton<BTN_BACK> btnBack;
+PressButton<BTN_UP> btnUp;
+PressButton<BTN_DOWN> btnDown;
+PressButton<BTN_PLUS> btnPlus;
+PressButton<BTN_MINUS> btnMinus;
+const uint8_t wakePins[] = {BTN_OK, BTN_BACK, BTN_UP, BTN_DOWN, BTN_PLUS, BTN_MINUS};     //any button wakes the device from power down
 
 // MENU STRUCTURE ------------------------------------------------------------------- 
 
@@ -40,25 +52,21 @@ enum pageType{
         MENU_SUB2,
         MENU_SUB3,
         MENU_SUB4,
-        MENU_SUB5,
-        MENU_SETTINGS
+        MENU_SETTINGS,
+        MENU_PAGE_CNT
 };
 
 enum pageType currPage = MENU_ROOT;
-void page_MenuRoot();
-void page_MenuSub1();
-void page_MenuSub1_A();
-void page_MenuSub1_B();
-void page_MenuSub2();
-void page_MenuSub3();
-void page_MenuSub4();
-void page_MenuSub5();
-void page_MenuSettings();
+MenuPage menuPage;                                              //RAM copy of the descriptor of the open page
+Pt menuPt;                                                      //menu protothread resume point
+void menuTask();                                                //menu protothread - opens the current page and steps it every PACING_MS
+void menuEnter(uint8_t id);                                     //opens the given page
+bool menuStep();                                                //one loop iteration of the open page, false once another page was selected
+void displayTask();                                             //sends whatever changed on the display
 
 
 // MENU INTERNALS ----------------------------------------------------------------------
 
-uint32_t loopStartMs;                                           //tracks when entered top of the lop
 bool updateAllitems;                                            //flag for updating items list
 bool updateItemvalue;                                        //position to update a specific items value
 uint8_t itemCnt;                                                //number of items in the current menu  
@@ -68,13 +76,15 @@ uint8_t root_pntrPos = 1;
 uint8_t root_dispOffSet = 0;
 uint8_t flashCntr;                                              //flash counter
 bool flashIsOn;                                                 //flash state
-void initMenuPages(String title, uint8_t itemCount );           //sets all the common menu values and prints the menu title
+void initMenuPages(const char *title, uint8_t titleLen, uint8_t itemCount); //sets all the common menu values and prints the PROGMEM menu title
 void captureButtonDownState();                                  //captures the pressed down state for all buttons (set only)
+uint32_t lastActivityMs;                                        //last time a button press was captured
+bool wakePress;                                                 //true from the wake up until every button is released
+void powerTask();                                               //powers down after SLEEP_AFTER_MS without a button press
 void adjustBoolean(bool *v);                                    // adjusts a Boolean value depending on the button state  
-void adjustUint8_t(uint8_t *v, uint8_t min, uint8_t max);       //adjusts a Boolean value depending on the button state
+void adjustUint8_t(uint8_t *v, uint8_t min, uint8_t max, const RepeatProfile *profile);        //adjusts a uint8_t value depending on the button state
 void doPointerNavigation();                                     //does the up/down point navigation
 bool isFlashChanged();                                          //Returns true whenever the flash state changes (flash interval = PACING_)
-void pacingWait();                                              //placed at the bottom of the loop to keep constant pacing of the intervals
 bool menuItemPrintable(uint8_t xPos, uint8_t yPos);             //will return a positive state if the item can be display - it will also posing  
 
 // PRINT TOOLS --------------------------------------------------------------------------------------
@@ -83,6 +93,9 @@ void printPointer();                                            //depending on f
 void printOffsetArrows();                                       //print the arrows to indicate if the menu extends beyond current view
 void printOnOff(boolean val);                                      //print either ON or OFF depending on the boolean state
 void printUint32_tAtWidth(uint32_t value, uint8_t width, char c, boolean isRight); 
+void printChars(uint8_t cnt, char c);                           //prints a character cnt times
+void printItemLabel(const MenuItem *item);                      //prints the label of a menu item, padded up to its value or the arrows
+void printItemValue(const MenuItem *item);                      //prints the bound value of a menu item
 
 // SETTINGS -------------------------------------------------------------------------------------------
 
@@ -101,46 +114,66 @@ void sets_Load();                                                //loads the set
 void sets_Save();                                                 //save the values in the settings object into the EEPROM
 
 // DISPLAY
-LiquidCrystal_I2C lcd(0x27, 16, 2);     // set the LCD address to ex27 for a 20 chars and 4 line display
-byte chrUp[] = {0b00000,                // Arrow up custom character data
-                0b00100,
-                0b00100,
-                0b01110,
-                0b01110,
-                0b11111,
-                0b11111,
-                0b00000 };
-byte chrDn[] = { 0b00000,                // Arrow down custom character data
-                0b11111,
-                0b11111,
-                0b01110,
-                0b01110,
-                0b00100,
-                0b00000 };
-byte chrF1[] = {0b10000,                // Menu title left side custom character data
-                0b01000,
-                0b10100,
-                0b01010,
-                0b10100,
-                0b01000,
-                0b10000,
-                0b00000 };
-byte chrF2[] = {0b00001,                // Menu title right side custom character data
-                0b00010,
-                0b00101,
-                0b01010,
-                0b00101,
-                0b00010,
-                0b00001,
-                0b00000 };
-byte chrAr[] = {0b00000,                // Selected item pointer custom character data
-                0b01100,
-                0b11110,
-                0b10010,
-                0b11110,
-                0b01100,
-                0b00000,
-                0b00000 };
+LcdI2C lcdHw(0x27, 16, 2);              // set the LCD address to ex27 for a 16 chars and 2 line display
+LcdShadow lcd(lcdHw);                   // RAM shadow of the display, only changed cells are sent by displayTask()
+enum glyphType{
+        GLYPH_UP,                       // Arrow up
+        GLYPH_DN,                       // Arrow down
+        GLYPH_F1,                       // Menu title left side
+        GLYPH_F2,                       // Menu title right side
+        GLYPH_AR,                       // Selected item pointer
+};
+const uint8_t glyphTable[][8] PROGMEM = {
+        {0b00000,                       // Arrow up
+         0b00100,
+         0b00100,
+         0b01110,
+         0b01110,
+         0b11111,
+         0b11111,
+         0b00000},
+        {0b00000,                       // Arrow down
+         0b11111,
+         0b11111,
+         0b01110,
+         0b01110,
+         0b00100,
+         0b00100,
+         0b00000},
+        {0b10000,                       // Menu title left side
+         0b01000,
+         0b10100,
+         0b01010,
+         0b10100,
+         0b01000,
+         0b10000,
+         0b00000},
+        {0b00001,                       // Menu title right side
+         0b00010,
+         0b00101,
+         0b01010,
+         0b00101,
+         0b00010,
+         0b00001,
+         0b00000},
+        {0b00000,                       // Selected item pointer
+         0b01100,
+         0b11110,
+         0b10010,
+         0b11110,
+         0b01100,
+         0b00000,
+         0b00000}
+};
+const uint8_t menuGlyphs[] = {GLYPH_UP, GLYPH_DN, GLYPH_F1, GLYPH_F2, GLYPH_AR};      //glyphs every menu page uses
+LcdGlyphs glyphs(lcd, glyphTable);      // CGRAM slots, glyphs are uploaded when a page needs them
+
+// TASKS
+Task tasks[] = {
+        TASK(menuTask, PACING_MS),      // menu pages, also the pace of the pointer flash
+        TASK(displayTask, PACING_MS),   // display flushing
+        TASK(powerTask, 100),           // power down when nobody uses the device
+};
 
 // ===========================================================
 // ||                   SETUP                               ||
@@ -148,11 +181,6 @@ byte chrAr[] = {0b00000,                // Selected item pointer custom characte
 void setup() {
 
         lcd.init();
-        lcd.createChar(1, chrUp);
-        lcd.createChar(1, chrDn);
-        lcd.createChar(1, chrF1);
-        lcd.createChar(1, chrF2);
-        lcd.createChar(1, chrAr);
 
         lcd.backlight();
 
@@ -164,402 +192,227 @@ void setup() {
 // ||                  MAIN LOOP                            ||
 //============================================================
 void loop() {
-        switch(currPage){
-        case MENU_ROOT : page_MenuRoot();break;
-        case MENU_SUB1 : page_MenuSub1();break;
-        case MENU_SUB1_A : page_MenuSub1_A();break;
-        case MENU_SUB1_B : page_MenuSub1_B();break;
-        case MENU_SUB2 : page_MenuSub2();break;
-        case MENU_SUB3 : page_MenuSub3();break;
-        case MENU_SUB4 : page_MenuSub4();break;
-        case MENU_SUB5 : page_MenuSub5();break;
-        case MENU_SETTINGS : page_MenuSettings();break;
-
-        }
-}
-// ===========================================================
-// ||                  MENU ROOT                            ||
-//============================================================
-void page_MenuRoot(){
-
-        //initializes menu pages
-        initMenuPages(F("MAIN MENU"), 6 );
-
-        // for the ROOT MENU we will recall last know position and off set of the display
-        pntrPos = root_pntrPos; dispOffset = root_dispOffSet; 
-
-        //inner loop
-        while (true){
-
-                //print the sipalay item when requested
-                if(updateAllitems){
+        //a new button event steps the menu at once instead of at its next pacing step
+        static uint8_t seenEvents;
+        if(bank_events != seenEvents){seenEvents = bank_events; tasks_due(&tasks[0]);}
 
-                        //print the visible item
-                        if(menuItemPrintable(1,1)){lcd.print(F("Sub Menu #1"));}
-                        if(menuItemPrintable(1,2)){lcd.print(F("Sub Menu #2"));}
-                        if(menuItemPrintable(1,3)){lcd.print(F("Sub Menu #3"));}
-                        if(menuItemPrintable(1,4)){lcd.print(F("Sub Menu #4"));}
-                        if(menuItemPrintable(1,5)){lcd.print(F("Settings   "));}
+        tasks_run(tasks, sizeof tasks / sizeof tasks[0]);
 
-                        printOffsetArrows();
-                }
-        
-                if(isFlashChanged()){printPointer();}
-
-                //alwats clear update flags by this point
-                updateAllitems = false;
-
-                //capture the button down state
-                captureButtonDownState();
-
-                //check for the ok button
-                if(btnOk.PressReleased()){
-
-                        //for the ROOT MENU we will save last know position and offset of the display
-                        root_pntrPos = pntrPos; root_dispOffSet = dispOffset; 
-                        switch (pntrPos){
-                                case 1: currPage = MENU_SUB1; return;
-                                case 2: currPage = MENU_SUB2; return;
-                                case 3: currPage = MENU_SUB3; return;
-                                case 4: currPage = MENU_SUB4; return;
-                                case 5: currPage = MENU_SETTINGS; return;
-                        }
-                }
-                
-                //otherwise check for pointer up or down button
-                doPointerNavigation();
-
-                //keep a specific pace
-                pacingWait();
-        }  
+        //nothing to do until the next interrupt, the millis tick at the latest
+        pwr_idle();
 }
 // ===========================================================
-// ||                  MENU SUB#1                            ||
+// ||                  MENU PAGES                           ||
 //============================================================
-void page_MenuSub1(){
-
-        //initializes menu pages
-        initMenuPages(F("SUB MENU 1"), 3 );
-
-        //inner loop
-        while (true){
-
-                //print the sipalay item when requested
-                if(updateAllitems){
-
-                        //print the visible item
-                        if(menuItemPrintable(1,1)){lcd.print(F("Sub Menu #1_A"));}
-                        if(menuItemPrintable(1,2)){lcd.print(F("Sub Menu #1_B"));}
-
-                        printOffsetArrows();
-                }
-        
-                if(isFlashChanged()){printPointer();}
 
-                //alwats clear update flags by this point
-                updateAllitems = false;
-
-                //capture the button down state
-                captureButtonDownState();
-
-                //check for the ok button
-                if(btnOk.PressReleased()){
-
-                        switch (pntrPos){
-                                case 1: currPage = MENU_SUB1_A; return;
-                                case 2: currPage = MENU_SUB1_B; return;
-                        }
-                }
-                else if(btnBack.PressReleased()){
+const char txtMainMenu[] PROGMEM = "MAIN MENU";
+const char txtSubMenu1[] PROGMEM = "SUB MENU 1";
+const char txtSubMenu1A[] PROGMEM = "SUB MENU 1_A";
+const char txtSubMenu1B[] PROGMEM = "SUB MENU 1_B";
+const char txtSubMenu2[] PROGMEM = "SUB MENU 2";
+const char txtSubMenu3[] PROGMEM = "SUB MENU 3";
+const char txtSubMenu4[] PROGMEM = "SUB MENU 4";
+const char txtSettings[] PROGMEM = "SETTINGS";
+
+const char txtItemSub1[] PROGMEM = "Sub Menu #1";
+const char txtItemSub2[] PROGMEM = "Sub Menu #2";
+const char txtItemSub3[] PROGMEM = "Sub Menu #3";
+const char txtItemSub4[] PROGMEM = "Sub Menu #4";
+const char txtItemSettings[] PROGMEM = "Settings";
+const char txtItemSub1A[] PROGMEM = "Sub Menu #1_A";
+const char txtItemSub1B[] PROGMEM = "Sub Menu #1_B";
+const char txtItemNone[] PROGMEM = "NO ITEM";
+const char txtItemOne[] PROGMEM = "Something one";
+const char txtItemTwo[] PROGMEM = "Something two";
+const char txtSetting1[] PROGMEM = "Setting 1 = ";
+const char txtSetting2[] PROGMEM = "Setting 2 = ";
+const char txtSetting3[] PROGMEM = "Setting 3 = ";
+const char txtSetting4[] PROGMEM = "Setting 4 = ";
+const char txtSetting5[] PROGMEM = "Setting 5 = ";
+const char txtSetting6[] PROGMEM = "Setting 6 = ";
+
+constexpr MenuItem itemsRoot[] PROGMEM = {
+        MENU_LINK(txtItemSub1, MENU_SUB1),
+        MENU_LINK(txtItemSub2, MENU_SUB2),
+        MENU_LINK(txtItemSub3, MENU_SUB3),
+        MENU_LINK(txtItemSub4, MENU_SUB4),
+        MENU_LINK(txtItemSettings, MENU_SETTINGS)
+};
+constexpr MenuItem itemsSub1[] PROGMEM = {
+        MENU_LINK(txtItemSub1A, MENU_SUB1_A),
+        MENU_LINK(txtItemSub1B, MENU_SUB1_B)
+};
+constexpr MenuItem itemsNone[] PROGMEM = {
+        MENU_TEXT(txtItemNone)
+};
+constexpr MenuItem itemsSomething[] PROGMEM = {
+        MENU_TEXT(txtItemOne),
+        MENU_TEXT(txtItemTwo)
+};
+constexpr MenuItem itemsSettings[] PROGMEM = {
+        MENU_BOOL(txtSetting1, settings.Test1_OnOff),
+        MENU_UINT8_FAST(txtSetting2, settings.Test2_Num, 0, 255, repeatFast8),
+        MENU_UINT8_FAST(txtSetting3, settings.Test3_Num, 0, 255, repeatFast8),
+        MENU_UINT8_FAST(txtSetting4, settings.Test4_Num, 0, 255, repeatFast8),
+        MENU_BOOL(txtSetting5, settings.Test5_OnnOff),
+        MENU_UINT8_FAST(txtSetting6, settings.Test6_Num, 0, 255, repeatFast8)
+};
 
-                        switch (pntrPos){case 1: currPage = MENU_ROOT; return;
-                        }
-                }
-                //otherwise check for pointer up or down button
-                doPointerNavigation();
+// id, title, items, parent, on enter, on loop, on leave
+constexpr MenuPage menuPages[] PROGMEM = {
+        {MENU_ROOT,     MENU_TITLE(txtMainMenu),  MENU_ITEMS(itemsRoot),      MENU_ROOT, nullptr, nullptr, nullptr},
+        {MENU_SUB1,     MENU_TITLE(txtSubMenu1),  MENU_ITEMS(itemsSub1),      MENU_ROOT, nullptr, nullptr, nullptr},
+        {MENU_SUB1_A,   MENU_TITLE(txtSubMenu1A), MENU_ITEMS(itemsNone),      MENU_SUB1, nullptr, nullptr, nullptr},
+        {MENU_SUB1_B,   MENU_TITLE(txtSubMenu1B), MENU_ITEMS(itemsNone),      MENU_SUB1, nullptr, nullptr, nullptr},
+        {MENU_SUB2,     MENU_TITLE(txtSubMenu2),  MENU_ITEMS(itemsSomething), MENU_ROOT, nullptr, nullptr, nullptr},
+        {MENU_SUB3,     MENU_TITLE(txtSubMenu3),  MENU_ITEMS(itemsSomething), MENU_ROOT, nullptr, nullptr, nullptr},
+        {MENU_SUB4,     MENU_TITLE(txtSubMenu4),  MENU_ITEMS(itemsSomething), MENU_ROOT, nullptr, nullptr, nullptr},
+        {MENU_SETTINGS, MENU_TITLE(txtSettings),  MENU_ITEMS(itemsSettings),  MENU_ROOT, nullptr, nullptr, sets_Save}
+};
+MENU_CHECK(menuPages, MENU_PAGE_CNT);
 
-                //keep a specific pace
-                pacingWait();
-        }  
-}
 // ===========================================================
-// ||                  MENU SUB#1_A                            ||
+// ||                  MENU ENGINE                          ||
 //============================================================
-void page_MenuSub1_A(){
-
-        //initializes menu pages
-        initMenuPages(F("SUB MENU 1_A"), 2 );
-
-        //inner loop
-        while (true){
-
-                //print the sipalay item when requested
-                if(updateAllitems){
-
-                        //print the visible item
-                        if(menuItemPrintable(1,1)){lcd.print(F("NO ITEM"));}
+void menuTask(){
 
-                        printOffsetArrows();
-                }
-        
-                if(isFlashChanged()){printPointer();}
-
-                //alwats clear update flags by this point
-                updateAllitems = false;
+        PT_BEGIN(menuPt);
 
-                //capture the button down state
-                captureButtonDownState();
-
-                //check for the ok button
-                if (btnBack.PressReleased()){currPage = MENU_SUB1; return;}
-                //otherwise check for pointer up or down button
-                doPointerNavigation();
+        //open the current page and step it until another page is selected
+        while(true){
+                menuEnter(currPage);
+                while(menuStep()){PT_YIELD(menuPt);}
+        }
 
-                //keep a specific pace
-                pacingWait();
-        }  
+        PT_END(menuPt);
 }
-// ===========================================================
-// ||                  MENU SUB#1_B                            ||
-//============================================================
-
-void page_MenuSub1_B(){
-       
-        //initializes menu pages
-        initMenuPages(F("SUB MENU 1_B"), 2 );
+void menuEnter(uint8_t id){
 
-        //inner loop
-        while (true){
+        //take a RAM copy of the page descriptor
+        memcpy_P(&menuPage, &menuPages[id], sizeof menuPage);
 
-                //print the sipalay item when requested
-                if(updateAllitems){
-
-                        //print the visible item
-                        if(menuItemPrintable(1,1)){lcd.print(F("NO ITEM"));}
-
-                        printOffsetArrows();
-                }
-        
-                if(isFlashChanged()){printPointer();}
-
-                //alwats clear update flags by this point
-                updateAllitems = false;
-
-                //capture the button down state
-                captureButtonDownState();
-
-                //check for the ok button
-                if (btnBack.PressReleased()){currPage = MENU_SUB1; return;}
-                //otherwise check for pointer up or down button
-                doPointerNavigation();
-
-                //keep a specific pace
-                pacingWait();
-        }  
-}
-// ===========================================================
-// ||                  MENU SUB#2                            ||
-//============================================================
-
-void page_MenuSub2(){
-        
         //initializes menu pages
-        initMenuPages(F("SUB MENU 2"), 3 );
+        initMenuPages(menuPage.title, menuPage.titleLen, menuPage.itemCount);
 
-        //inner loop
-        while (true){
-
-                //print the sipalay item when requested
-                if(updateAllitems){
-
-                        //print the visible item
-                        if(menuItemPrintable(1,1)){lcd.print(F("Something one"));}
-                        if(menuItemPrintable(1,2)){lcd.print(F("Something two"));}
-
-                        printOffsetArrows();
-                }
-        
-                if(isFlashChanged()){printPointer();}
-
-                //alwats clear update flags by this point
-                updateAllitems = false;
-
-                //capture the button down state
-                captureButtonDownState();
-
-                if(btnBack.PressReleased()){currPage = MENU_ROOT; return;}
-                
-                //otherwise check for pointer up or down button
-                doPointerNavigation();
+        // for the ROOT MENU we will recall last know position and off set of the display
+        if(id == MENU_ROOT){pntrPos = root_pntrPos; dispOffset = root_dispOffSet;}
 
-                //keep a specific pace
-                pacingWait();
-        }  
+        if(menuPage.onEnter){menuPage.onEnter();}
 }
-// ===========================================================
-// ||                  MENU SUB#3                            ||
-//============================================================
-
-void page_MenuSub3(){
-        
-       //initializes menu pages
-        initMenuPages(F("SUB MENU 3"), 3 );
-
-        //inner loop
-        while (true){
+bool menuStep(){
 
-                //print the sipalay item when requested
-                if(updateAllitems){
+        MenuItem item;
 
-                        //print the visible item
-                        if(menuItemPrintable(1,1)){lcd.print(F("Something one"));}
-                        if(menuItemPrintable(1,2)){lcd.print(F("Something two"));}
+        //print the display items when requested
+        if(updateAllitems){
 
-                        printOffsetArrows();
+                //print the visible items
+                for(uint8_t i = 0; i < menuPage.itemCount; i++){
+                        if(menuItemPrintable(1, i + 1)){memcpy_P(&item, &menuPage.items[i], sizeof item); printItemLabel(&item);}
                 }
-        
-                if(isFlashChanged()){printPointer();}
 
-                //alwats clear update flags by this point
-                updateAllitems = false;
+                printOffsetArrows();
+        }
 
-                //capture the button down state
-                captureButtonDownState();
+        //print the bound values when requested
+        if(updateAllitems || updateItemvalue){
 
-                if(btnBack.PressReleased()){currPage = MENU_ROOT; return;}
-                
-                //otherwise check for pointer up or down button
-                doPointerNavigation();
+                for(uint8_t i = 0; i < menuPage.itemCount; i++){
+                        memcpy_P(&item, &menuPage.items[i], sizeof item);
+                        if(item.kind >= MI_BOOL && menuItemPrintable(MENU_VALUE_COL, i + 1)){printItemValue(&item);}
+                }
+        }
 
-                //keep a specific pace
-                pacingWait();
-        }  
-}
-// ===========================================================
-// ||                  MENU SUB#4                            ||
-//============================================================
+        //page specific work
+        if(menuPage.onLoop){menuPage.onLoop();}
 
-void page_MenuSub4(){
-        
-        //initializes menu pages
-        initMenuPages(F("SUB MENU 4"), 3 );
+        if(isFlashChanged()){printPointer();}
 
-        //inner loop
-        while (true){
+        //always clear update flags by this point
+        updateAllitems = false;
+        updateItemvalue = false;
 
-                //print the sipalay item when requested
-                if(updateAllitems){
+        //capture the button down state
+        captureButtonDownState();
 
-                        //print the visible item
-                        if(menuItemPrintable(1,1)){lcd.print(F("Something one"));}
-                        if(menuItemPrintable(1,2)){lcd.print(F("Something two"));}
+        //check for the ok button on the selected item, otherwise the back button
+        uint8_t nextPage = menuPage.id;
+        if(menuPage.itemCount > 0){memcpy_P(&item, &menuPage.items[pntrPos - 1], sizeof item);} else {item.kind = MI_TEXT;}
 
-                        printOffsetArrows();
+        if(btnOk.PressReleased()){
+                switch (item.kind){
+                        case MI_PAGE: nextPage = item.page; break;
+                        case MI_BACK: nextPage = menuPage.parent; break;
+                        case MI_ACTION: item.action(); break;
                 }
-        
-                if(isFlashChanged()){printPointer();}
-
-                //alwats clear update flags by this point
-                updateAllitems = false;
+        }
+        else if(btnBack.PressReleased()){nextPage = menuPage.parent;}
 
-                //capture the button down state
-                captureButtonDownState();
+        //leave the page when another page was selected
+        if(nextPage != menuPage.id){
 
-                if(btnBack.PressReleased()){currPage = MENU_ROOT; return;}
-                
-                //otherwise check for pointer up or down button
-                doPointerNavigation();
+                //for the ROOT MENU we will save last know position and offset of the display
+                if(menuPage.id == MENU_ROOT){root_pntrPos = pntrPos; root_dispOffSet = dispOffset;}
 
-                //keep a specific pace
-                pacingWait();
-        }  
-}
-// ===========================================================
-// ||                  MENU SUB#5                            ||
-//============================================================
-void page_MenuSub5(){
-        while (true){}
-}
-// ===========================================================
-// ||                  MENU settings                            ||
-//============================================================
-void page_MenuSettings(){
-        //initializes menu pages
-        initMenuPages(F("SETTINGS"), 7 );
+                if(menuPage.onLeave){menuPage.onLeave();}
+                currPage = (pageType)nextPage;
+                return false;
+        }
 
-        //inner loop
-        while (true){
+        //otherwise check for pointer up or down button
+        doPointerNavigation();
 
-                //print the sipalay item when requested
-                if(updateAllitems){
+        //editing action based on selected item > MUST BE AFTER NAVIGATION TO ENSURE CORRECT SCREEN UPDATE!!
+        if(menuPage.itemCount > 0){
+                memcpy_P(&item, &menuPage.items[pntrPos - 1], sizeof item);
+                if(item.kind == MI_BOOL){adjustBoolean((bool *)item.value);}
+                else if(item.kind == MI_UINT8){adjustUint8_t((uint8_t *)item.value, item.min, item.max, item.repeat ? item.repeat : &repeatDefault);}
+        }
 
-                        //print the visible item
-                        if(menuItemPrintable(1,1)){lcd.print(F("Setting 1 = "));}
-                        if(menuItemPrintable(1,2)){lcd.print(F("Setting 2 = "));}
-                        if(menuItemPrintable(1,3)){lcd.print(F("Setting 3 = "));}
-                        if(menuItemPrintable(1,4)){lcd.print(F("Setting 4 = "));}
-                        if(menuItemPrintable(1,5)){lcd.print(F("Setting 5 = "));}
-                        if(menuItemPrintable(1,6)){lcd.print(F("Setting 6 = "));}
+        return true;
+}
+void displayTask(){
 
-                        printOffsetArrows();
-                }
-                if(updateAllitems || updateItemvalue){
-
-                        if(menuItemPrintable(13,1)){printOnOff(settings.Test1_OnOff);}
-                        if(menuItemPrintable(13,2)){printUint32_tAtWidth(settings.Test2_Num, 3, ' ', false);}
-                        if(menuItemPrintable(13,3)){printUint32_tAtWidth(settings.Test3_Num, 3, ' ', false);}
-                        if(menuItemPrintable(13,4)){printUint32_tAtWidth(settings.Test4_Num, 3, ' ', false);}
-                        if(menuItemPrintable(13,5)){printOnOff(settings.Test5_OnnOff);}
-                        if(menuItemPrintable(13,6)){printUint32_tAtWidth(settings.Test6_Num, 3, ' ', false);}
-                }
-                if(isFlashChanged()){printPointer();}
+        //send whatever changed on the display since the last pass
+        lcd.commit();
+}
+void powerTask(){
 
-                //always clear update flags by this point
-                updateAllitems = false;
-                updateItemvalue = false;
+        //stay awake while the device is used
+        if(SLEEP_AFTER_MS == 0 || millis() - lastActivityMs < SLEEP_AFTER_MS){return;}
 
-                //capture the button down state
-                captureButtonDownState();
+        //display and backlight off, the commands have to reach the display before the clocks stop
+        lcd.noBacklight();
+        lcdHw.noDisplay();
+        lcdHw.flush();
 
-                //go back to menu layer
-                if(btnBack.PressReleased()){currPage = MENU_ROOT; sets_Save(); return;}
-                
-                //otherwise check for pointer up or down button
-                doPointerNavigation();
-
-                //editing action based on selected item > MUST BE AFTER NAVIGATION TO ENSURE CORRECT SCREEN UPDATE!!
-                switch (pntrPos)
-                {
-                        case 1: adjustBoolean(&settings.Test1_OnOff); break;
-                        case 2: adjustUint8_t(&settings.Test2_Num, 0, 255); break;
-                        case 3: adjustUint8_t(&settings.Test3_Num, 0, 255); break;
-                        case 4: adjustUint8_t(&settings.Test4_Num, 0, 255); break;
-                        case 5: adjustBoolean(&settings.Test5_OnnOff); break;
-                        case 6: adjustUint8_t(&settings.Test6_Num, 0, 255); break;
-                
-                }
+        pwr_powerDown(wakePins, sizeof wakePins);
 
-                //if(btnOk.LongPressed()){ sets_SetDefaults(); updateAllitems = true ;}
-                //keep a specific pace
-                pacingWait();
-        }  
+        //back on where we left off, the display kept its contents
+        lcdHw.display();
+        lcd.backlight();
+        wakePress = true;
+        lastActivityMs = millis();
 }
 
 // ===========================================================
 // ||               TOOLS - MENU INTERVALS                  ||
 //============================================================
 
-void initMenuPages(String title, uint8_t itemCount ){
+void initMenuPages(const char *title, uint8_t titleLen, uint8_t itemCount){
 
         lcd.clear();
 
         lcd.setCursor(0,0);
 
-        uint8_t fillCnt = (DISP_CHAR_WIDTH - title.length()) / 2;
-        if(fillCnt > 0){for(uint8_t i = 0; i< fillCnt; i++){lcd.print(F("\03"));}}
-        lcd.print(title);
-        if ((title.length() % 2 ) == 1){fillCnt++;}
-        if(fillCnt > 0){for(uint8_t i = 0; i < fillCnt; i++){lcd.print(F("\04"));}}
+        //make sure the menu glyphs are in CGRAM before anything is drawn with them
+        glyphs.load(menuGlyphs, sizeof menuGlyphs);
+
+        //centre the title between the fill characters, the title is streamed straight from flash
+        uint8_t fillCnt = (DISP_CHAR_WIDTH - titleLen) / 2;
+        printChars(fillCnt, glyphs.code(GLYPH_F1));
+        lcd.print(FPSTR(title));
+        printChars(DISP_CHAR_WIDTH - titleLen - fillCnt, glyphs.code(GLYPH_F2));
 
         //clear all button states
         btnUp.CleasWasDown();
@@ -586,27 +439,39 @@ void initMenuPages(String title, uint8_t itemCount ){
 
         // force a full update
         updateAllitems = true;
-
-        //capture start time
-        loopStartMs = millis();
 }           
 void captureButtonDownState(){
 
-        btnUp.CaptureDownState();
-        btnDown.CaptureDownState();
-        btnOk.CaptureDownState();
-        btnBack.CaptureDownState();
-        btnMinus.CaptureDownState();
-        btnPlus.CaptureDownState();
+        //hand the presses latched by the button bank to the buttons
+        bool pressed = PressButtonBase::Dispatch();
+
+        //the press that woke the device up is not a menu action, nothing is captured until every button is up again
+        if(wakePress){
+                btnUp.CleasWasDown(); btnDown.CleasWasDown(); btnOk.CleasWasDown(); btnBack.CleasWasDown(); btnMinus.CleasWasDown(); btnPlus.CleasWasDown();
+                if(btnUp.IsUp() && btnDown.IsUp() && btnOk.IsUp() && btnBack.IsUp() && btnMinus.IsUp() && btnPlus.IsUp()){wakePress = false;}
+                return;
+        }
+
+        pressed |= btnUp.CaptureDownState();
+        pressed |= btnDown.CaptureDownState();
+        pressed |= btnOk.CaptureDownState();
+        pressed |= btnBack.CaptureDownState();
+        pressed |= btnMinus.CaptureDownState();
+        pressed |= btnPlus.CaptureDownState();
+
+        //a pressed button keeps the device awake
+        if(pressed){lastActivityMs = millis();}
 }                                  
 void adjustBoolean(boolean *v){
         if(btnPlus.PressReleased() || btnMinus.PressReleased()){*v = !*v; updateItemvalue = true;}
 }                                    
-void adjustUint8_t(uint8_t *v, uint8_t min, uint8_t max){
-        
-        if (btnPlus.RepeatCnt == 0 && btnMinus.Repeated()){if(*v > min){*v = *v - 1; updateItemvalue = true;}}
+void adjustUint8_t(uint8_t *v, uint8_t min, uint8_t max, const RepeatProfile *profile){
+
+        //the profile sets how fast and by how much a held button moves the value, clamped to min and max
+        uint16_t step;
+        if (btnPlus.RepeatCnt() == 0 && (step = btnMinus.Repeated(profile))){if(*v > min){*v = *v - min > step ? *v - step : min; updateItemvalue = true;}}
 
-        if (btnMinus.RepeatCnt == 0 && btnPlus.Repeated()){if(*v < max){*v = *v + 1; updateItemvalue = true;}}
+        if (btnMinus.RepeatCnt() == 0 && (step = btnPlus.Repeated(profile))){if(*v < max){*v = max - *v > step ? *v + step : max; updateItemvalue = true;}}
 }  
 void doPointerNavigation(){
 
@@ -653,14 +518,6 @@ bool isFlashChanged(){
         //decrease the flash counter and send a negative response
         else {flashCntr--;return false;}
 }                                          
-void pacingWait(){
-
-        //do the pacing wait
-        while(millis() - loopStartMs < PACING_MS){delay(1);}
-
-        //capture start time
-        loopStartMs = millis();
-}
                                               
 bool menuItemPrintable(uint8_t xPos, uint8_t yPos){
 
@@ -693,7 +550,7 @@ void printPointer(){
         lcd.setCursor(0, pntrPos- dispOffset);
 
         //show the pointer if set
-        if(flashIsOn){lcd.print(F("\05"));}
+        if(flashIsOn){lcd.write(glyphs.code(GLYPH_AR));}
 
         //otherwise hide the pointer
         else{lcd.print(F(" "));}
@@ -701,11 +558,25 @@ void printPointer(){
 void printOffsetArrows(){
 
         lcd.setCursor(DISP_CHAR_WIDTH - 1, 1);
-        if(dispOffset > 0 ){ lcd.print(F("\01"));} else{lcd.print(F(" "));}
+        if(dispOffset > 0 ){ lcd.write(glyphs.code(GLYPH_UP));} else{lcd.print(F(" "));}
 
         lcd.setCursor(DISP_CHAR_WIDTH - 1, DISP_ITEM_ROWS);
-        if(itemCnt > DISP_ITEM_ROWS && itemCnt - DISP_ITEM_ROWS > dispOffset){lcd.print(F("\02"));} else{lcd.print(F(" "));}
+        if(itemCnt > DISP_ITEM_ROWS && itemCnt - DISP_ITEM_ROWS > dispOffset){lcd.write(glyphs.code(GLYPH_DN));} else{lcd.print(F(" "));}
 }                                       
+void printItemLabel(const MenuItem *item){
+
+        lcd.print(FPSTR(item->label));
+
+        //pad up to the value column, or up to the arrows column for items without a value
+        uint8_t endCol = item->kind >= MI_BOOL ? MENU_VALUE_COL : DISP_CHAR_WIDTH - 1;
+        uint8_t len = item->labelLen + 1;
+        if(len < endCol){printChars(endCol - len, ' ');}
+}
+void printItemValue(const MenuItem *item){
+
+        if(item->kind == MI_BOOL){printOnOff(*(bool *)item->value);}
+        else{printUint32_tAtWidth(*(uint8_t *)item->value, 3, ' ', false);}
+}
 void printOnOff(bool val){
 
         if(val){lcd.print(F("ON "));}
@@ -714,40 +585,18 @@ void printOnOff(bool val){
 
 void printChars(uint8_t cnt, char c){
 
-        //only bother if char count is more than zero
-        if(cnt > 0 ){
-
-                // build the character array with the single character ready for printing
-                char cc[] = " "; cc[0] = c;
-
-                //print "cnt" number of the specified character
-                for(uint8_t i = 1; i<= cnt; i++){lcd.print(cc);}
-        }
+        //write the character one by one (a custom character may be code 0, which print() would stop at)
+        for(uint8_t i = 0; i < cnt; i++){lcd.write(c);}
 }
-uint8_t getUint32_tCharCnt(uint32_t value){
-
-        //value id zero then return 1
-        if(value == 0){return 1;}
-
-        //setup the working variables
-        uint32_t tensCalc = 10;uint8_t cnt = 1;
-
-        //keep increasing the tensCalc value and counting the digits for as long as the tensCalc value is lower than the value
-        while(tensCalc <= value && cnt < 20){tensCalc *=10; cnt += 1;}
-
-        //return the result!
-        return cnt;
-}
-
 void printUint32_tAtWidth(uint32_t value, uint8_t width, char c, boolean isRight){
 
-        uint8_t numChars = getUint32_tCharCnt(value);
-
-        if(isRight){printChars(width- numChars, c);}
-
-        lcd.print(value);
+        //the field never needs to be wider than the display
+        if(width > DISP_CHAR_WIDTH){width = DISP_CHAR_WIDTH;}
 
-        if(!isRight){printChars(width-numChars,c);}
+        //format the padded field without any division and send it in one go
+        char buf[DISP_CHAR_WIDTH];
+        uint8_t len = numfmt_u32(buf, value, width, c, isRight);
+        lcd.write((const uint8_t *)buf, len);
 } 
 
 // ===========================================================